@@ -0,0 +1,351 @@
+"""Measure how rules_verilog scales across the synthetic designs in this package.
+
+For each design size this script runs, from a clean output tree:
+
+1. An analysis-only build of the `{size}_sim` binary to measure loading/analysis time.
+2. `bazel aquery` to count the actions registered for the binary.
+3. A full build of the binary with an execution log to measure time spent per
+   mnemonic (`Verilate`, `CppCompile`, `CppLink`, ...).
+4. A build of every `verilog_library` in the design with `--config=verilator_lint`
+   to measure the cost of the lint aspect. The aspect only applies to top level
+   targets, so the libraries are built directly rather than the binary.
+
+Usage:
+
+```
+bazel run //tools/scaling:benchmark -- --size small --size medium
+```
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+from collections import defaultdict
+from pathlib import Path
+from typing import Any, Dict, Iterator, List, Sequence
+
+SIZES = ("small", "medium", "large")
+
+PACKAGE = "//tools/scaling"
+
+MNEMONICS = (
+    "Verilate",
+    "VerilatorLint",
+    "CppCompile",
+    "CppArchive",
+    "CppLink",
+)
+
+ANALYSIS_PHASE = "Load and analyze dependencies"
+
+
+def parse_args() -> argparse.Namespace:
+    """Parse command line arguments."""
+    parser = argparse.ArgumentParser(description=__doc__)
+
+    parser.add_argument(
+        "--size",
+        dest="sizes",
+        action="append",
+        choices=SIZES,
+        help="A design size to benchmark. May be passed multiple times. Defaults to all sizes.",
+    )
+    parser.add_argument(
+        "--bazel",
+        default=os.getenv("BAZEL_REAL", "bazel"),
+        help="The Bazel binary to use.",
+    )
+    parser.add_argument(
+        "--workspace",
+        type=Path,
+        default=Path(os.getenv("BUILD_WORKSPACE_DIRECTORY", ".")),
+        help="The workspace to run Bazel in.",
+    )
+    parser.add_argument(
+        "--output",
+        type=Path,
+        help="An optional path to write the results to as JSON.",
+    )
+
+    args = parser.parse_args()
+    if not args.sizes:
+        args.sizes = list(SIZES)
+
+    return args
+
+
+class Bazel:
+    """A thin wrapper for invoking Bazel in a workspace."""
+
+    def __init__(self, bazel: str, workspace: Path) -> None:
+        self.bazel = bazel
+        self.workspace = workspace
+
+    def run(self, command: str, *args: str, capture: bool = False) -> str:
+        """Run a Bazel command, failing on errors.
+
+        Args:
+            command: The Bazel command (`build`, `aquery`, ...).
+            args: Arguments for the command.
+            capture: Whether or not to return stdout.
+
+        Returns:
+            The stdout of the command if `capture` was requested.
+        """
+        result = subprocess.run(
+            [self.bazel, command, *args],
+            cwd=self.workspace,
+            check=True,
+            encoding="utf-8",
+            stdout=subprocess.PIPE if capture else None,
+        )
+        return result.stdout if capture else ""
+
+    def query(self, expression: str) -> List[str]:
+        """Run `bazel query` and return the resulting labels.
+
+        Args:
+            expression: The query expression.
+
+        Returns:
+            The labels matching the expression.
+        """
+        return self.run("query", expression, "--output=label", capture=True).split()
+
+    def clean_build(self, *args: str) -> float:
+        """Run a build from a clean output tree.
+
+        Args:
+            args: Arguments for `bazel build`.
+
+        Returns:
+            The wall time of the build in seconds.
+        """
+        self.run("clean")
+        # Caches would otherwise hide all of the work being measured.
+        start = time.monotonic()
+        self.run(
+            "build",
+            "--disk_cache=",
+            "--noremote_accept_cached",
+            *args,
+        )
+        return time.monotonic() - start
+
+
+def iter_json_stream(text: str) -> Iterator[Dict[str, Any]]:
+    """Iterate over a stream of concatenated JSON objects.
+
+    Args:
+        text: The content of a Bazel JSON execution log.
+
+    Yields:
+        Each JSON object in the stream.
+    """
+    decoder = json.JSONDecoder()
+    pos = 0
+    while True:
+        while pos < len(text) and text[pos].isspace():
+            pos += 1
+        if pos >= len(text):
+            return
+        obj, pos = decoder.raw_decode(text, pos)
+        yield obj
+
+
+def parse_duration(value: str) -> float:
+    """Parse a protobuf JSON duration (e.g. `1.5s`) into seconds."""
+    return float(value.rstrip("s")) if value else 0.0
+
+
+def summarize_execution_log(path: Path) -> Dict[str, float]:
+    """Sum spawn wall time per mnemonic from a JSON execution log.
+
+    Args:
+        path: The path to a log written by `--execution_log_json_file`.
+
+    Returns:
+        A mapping of mnemonic to total seconds.
+    """
+    totals: Dict[str, float] = defaultdict(float)
+    for spawn in iter_json_stream(path.read_text(encoding="utf-8")):
+        mnemonic = spawn.get("mnemonic", "")
+        metrics = spawn.get("metrics", {})
+        totals[mnemonic] += parse_duration(metrics.get("totalTime", ""))
+
+    return dict(totals)
+
+
+def summarize_analysis_time(path: Path) -> float:
+    """Extract the loading/analysis phase duration from a JSON trace profile.
+
+    Args:
+        path: The path to a profile written by `--profile`.
+
+    Returns:
+        The duration of the analysis phase in seconds.
+    """
+    profile = json.loads(path.read_text(encoding="utf-8"))
+    events = profile["traceEvents"] if isinstance(profile, dict) else profile
+
+    markers = sorted(
+        (event["ts"], event["name"])
+        for event in events
+        if event.get("cat") == "build phase marker"
+    )
+    for (start, name), (end, _) in zip(markers, markers[1:]):
+        if name == ANALYSIS_PHASE:
+            return float(end - start) / 1_000_000
+
+    raise ValueError(f"No `{ANALYSIS_PHASE}` phase found in {path}")
+
+
+def count_actions(bazel: Bazel, target: str) -> Dict[str, int]:
+    """Count actions registered for a target, grouped by mnemonic.
+
+    Args:
+        bazel: The Bazel wrapper.
+        target: The target to query.
+
+    Returns:
+        A mapping of mnemonic to action count.
+    """
+    output = bazel.run(
+        "aquery",
+        f"deps({target})",
+        "--output=text",
+        "--include_commandline=false",
+        capture=True,
+    )
+
+    counts: Dict[str, int] = defaultdict(int)
+    for match in re.finditer(r"^action '.*'\n\s+Mnemonic: (\S+)", output, re.M):
+        counts[match.group(1)] += 1
+
+    return dict(counts)
+
+
+def design_libraries(bazel: Bazel, size: str) -> List[str]:
+    """Find every `verilog_library` generated for a design.
+
+    Args:
+        bazel: The Bazel wrapper.
+        size: The name of the synthetic design.
+
+    Returns:
+        The labels of the design's libraries.
+    """
+    return bazel.query(
+        f'filter("^{PACKAGE}:{size}(_l[0-9]+_m[0-9]+)?$", '
+        f"kind(verilog_library, {PACKAGE}:all))"
+    )
+
+
+def benchmark(bazel: Bazel, size: str, tmp_dir: Path) -> Dict[str, Any]:
+    """Benchmark a single design size.
+
+    Args:
+        bazel: The Bazel wrapper.
+        size: The name of the synthetic design.
+        tmp_dir: A directory for profiles and logs.
+
+    Returns:
+        The collected measurements.
+    """
+    target = f"{PACKAGE}:{size}_sim"
+    profile = tmp_dir / f"{size}.profile.json"
+    exec_log = tmp_dir / f"{size}.exec.json"
+    lint_exec_log = tmp_dir / f"{size}.lint.exec.json"
+    lint_targets = tmp_dir / f"{size}.lint.targets.txt"
+
+    bazel.clean_build("--nobuild", f"--profile={profile}", target)
+    analysis = summarize_analysis_time(profile)
+
+    actions = count_actions(bazel, target)
+
+    build_wall = bazel.clean_build(f"--execution_log_json_file={exec_log}", target)
+    build_times = summarize_execution_log(exec_log)
+
+    libraries = design_libraries(bazel, size)
+    lint_targets.write_text("\n".join(libraries) + "\n", encoding="utf-8")
+
+    # `verilog_library` itself registers no actions, so everything this build
+    # does is the cost of linting.
+    lint_wall = bazel.clean_build(
+        "--config=verilator_lint",
+        f"--execution_log_json_file={lint_exec_log}",
+        f"--target_pattern_file={lint_targets}",
+    )
+    lint_times = summarize_execution_log(lint_exec_log)
+
+    return {
+        "target": target,
+        "analysis_seconds": analysis,
+        "action_count": sum(actions.values()),
+        "actions": actions,
+        "build_wall_seconds": build_wall,
+        "build_seconds": build_times,
+        "lint_targets": len(libraries),
+        "lint_wall_seconds": lint_wall,
+        "lint_seconds": lint_times.get("VerilatorLint", 0.0),
+    }
+
+
+def format_report(results: Dict[str, Dict[str, Any]]) -> str:
+    """Render results as a plain text table."""
+    header = ["size", "analysis", "actions"]
+    header.extend(MNEMONICS)
+    header.extend(["build wall", "lint wall"])
+
+    rows: List[Sequence[str]] = [header]
+    for size, result in results.items():
+        row = [
+            size,
+            f"{result['analysis_seconds']:.2f}s",
+            str(result["action_count"]),
+        ]
+        for mnemonic in MNEMONICS:
+            times = (
+                result["lint_seconds"]
+                if mnemonic == "VerilatorLint"
+                else result["build_seconds"].get(mnemonic, 0.0)
+            )
+            row.append(f"{times:.2f}s")
+        row.append(f"{result['build_wall_seconds']:.2f}s")
+        row.append(f"{result['lint_wall_seconds']:.2f}s")
+        rows.append(row)
+
+    widths = [max(len(row[i]) for row in rows) for i in range(len(header))]
+    return "\n".join(
+        "  ".join(cell.ljust(width) for cell, width in zip(row, widths)).rstrip()
+        for row in rows
+    )
+
+
+def main() -> None:
+    """The main entrypoint."""
+    args = parse_args()
+
+    bazel = Bazel(args.bazel, args.workspace)
+
+    results: Dict[str, Dict[str, Any]] = {}
+    with tempfile.TemporaryDirectory(prefix="rules_verilog_benchmark_") as tmp:
+        for size in args.sizes:
+            print(f"Benchmarking {size}...", file=sys.stderr)
+            results[size] = benchmark(bazel, size, Path(tmp))
+
+    print(format_report(results))
+
+    if args.output:
+        args.output.write_text(
+            json.dumps(results, indent=4, sort_keys=True) + "\n", encoding="utf-8"
+        )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,31 @@
+// A minimal driver so the benchmark measures linking a binary against a
+// synthetic model. `MODEL` is the generated model class (e.g. `Vsmall`).
+
+#include <verilated.h>
+
+#include <memory>
+
+#define STRINGIFY_IMPL(x) #x
+#define STRINGIFY(x) STRINGIFY_IMPL(x)
+
+#include STRINGIFY(MODEL.h)
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+
+    std::unique_ptr<MODEL> model = std::make_unique<MODEL>();
+
+    model->clk = 0;
+    model->rst_n = 0;
+    model->data_in = 1;
+    model->eval();
+
+    model->rst_n = 1;
+    for (int cycle = 0; cycle < 16; ++cycle) {
+        model->clk = !model->clk;
+        model->eval();
+    }
+
+    model->final();
+    return 0;
+}
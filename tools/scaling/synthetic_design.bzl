@@ -0,0 +1,214 @@
+"""Synthetic `verilog_library` graphs for measuring how the rules scale."""
+
+load("//verilog:verilog_library.bzl", "verilog_library")
+
+def _level_sizes(modules, depth, fanout):
+    """Distribute `modules` across `depth` levels.
+
+    Level 0 always holds the single top module. Every level can hold at most
+    `fanout` times as many modules as the level above it so that each module
+    is instantiated at least once.
+
+    Args:
+        modules (int): The total number of modules in the design.
+        depth (int): The number of levels in the instance hierarchy.
+        fanout (int): The number of child instances per non-leaf module.
+
+    Returns:
+        list: The number of modules on each level.
+    """
+    sizes = [1]
+    remaining = modules - 1
+    for level in range(1, depth):
+        levels_left = depth - level
+        target = (remaining + levels_left - 1) // levels_left
+        size = min(target, sizes[-1] * fanout)
+        sizes.append(size)
+        remaining -= size
+
+    if remaining > 0:
+        fail("Cannot fit {} modules into depth {} with fanout {}. Increase `depth` or `fanout`.".format(
+            modules,
+            depth,
+            fanout,
+        ))
+
+    # Trailing empty levels are simply dropped.
+    return [size for size in sizes if size > 0]
+
+def _module_name(prefix, level, index):
+    return "{}_l{}_m{}".format(prefix, level, index)
+
+def _render_module(name, width, stages, children):
+    """Render the SystemVerilog source of a single synthetic module.
+
+    Args:
+        name (str): The module name.
+        width (int): The data path width in bits.
+        stages (int): The number of pipeline stages of logic in the module.
+        children (list): Module names to instantiate, in order.
+
+    Returns:
+        str: The module source.
+    """
+    bus = "[{}:0]".format(width - 1)
+    pad = " " * (len(bus) + 1)
+    lines = [
+        "module {} (".format(name),
+        "    input  logic {}clk,".format(pad),
+        "    input  logic {}rst_n,".format(pad),
+        "    input  logic {} data_in,".format(bus),
+        "    output logic {} data_out".format(bus),
+        ");",
+    ]
+
+    for stage in range(stages):
+        lines.append("    logic {} stage_{};".format(bus, stage))
+    for child in range(len(children)):
+        lines.append("    logic {} child_{}_out;".format(bus, child))
+    lines.append("    logic {} mixed;".format(bus))
+    lines.append("")
+
+    for child, child_name in enumerate(children):
+        lines.extend([
+            "    {} u_child_{} (".format(child_name, child),
+            "        .clk     (clk),",
+            "        .rst_n   (rst_n),",
+            "        .data_in (stage_{} ^ {}'({})),".format(stages - 1, width, child + 1),
+            "        .data_out(child_{}_out)".format(child),
+            "    );",
+            "",
+        ])
+
+    # Fold every child output into the first stage so nothing is left unused.
+    mixed = "data_in"
+    for child in range(len(children)):
+        mixed = "({} ^ child_{}_out)".format(mixed, child)
+    lines.append("    assign mixed = {};".format(mixed))
+    lines.append("")
+
+    # Alternate between a few operator families so the per-module logic looks
+    # like a real data path rather than a chain of identical registers.
+    for stage in range(stages):
+        prev = "mixed" if stage == 0 else "stage_{}".format(stage - 1)
+        kind = stage % 3
+        if kind == 0:
+            expr = "{} + {{{}[{}:0], {}[{}]}}".format(prev, prev, width - 2, prev, width - 1)
+        elif kind == 1:
+            expr = "{} ^ {{{}[0], {}[{}:1]}}".format(prev, prev, prev, width - 1)
+        else:
+            expr = "{}[0] ? ({} & ~{}'({})) : ({} | {}'({}))".format(
+                prev,
+                prev,
+                width,
+                stage,
+                prev,
+                width,
+                stage,
+            )
+        lines.extend([
+            "    always_ff @(posedge clk or negedge rst_n) begin",
+            "        if (!rst_n) stage_{} <= '0;".format(stage),
+            "        else stage_{} <= {};".format(stage, expr),
+            "    end",
+            "",
+        ])
+
+    lines.append("    assign data_out = stage_{};".format(stages - 1))
+    lines.append("endmodule")
+    return "\n".join(lines) + "\n"
+
+def _synthetic_verilog_module_impl(ctx):
+    output = ctx.actions.declare_file("{}.sv".format(ctx.attr.module_name))
+    ctx.actions.write(
+        output = output,
+        content = _render_module(
+            name = ctx.attr.module_name,
+            width = ctx.attr.width,
+            stages = ctx.attr.stages,
+            children = ctx.attr.children,
+        ),
+    )
+
+    return [DefaultInfo(files = depset([output]))]
+
+_synthetic_verilog_module = rule(
+    doc = "Writes the source of a single synthetic SystemVerilog module.",
+    implementation = _synthetic_verilog_module_impl,
+    attrs = {
+        "children": attr.string_list(
+            doc = "Names of modules to instantiate.",
+        ),
+        "module_name": attr.string(
+            doc = "The name of the module (and the generated file).",
+            mandatory = True,
+        ),
+        "stages": attr.int(
+            doc = "The number of pipeline stages of logic in the module.",
+            mandatory = True,
+        ),
+        "width": attr.int(
+            doc = "The data path width in bits.",
+            mandatory = True,
+        ),
+    },
+)
+
+def synthetic_verilog_design(
+        *,
+        name,
+        modules,
+        depth,
+        fanout,
+        width = 16,
+        stages = 4,
+        **kwargs):
+    """Generate a synthetic `verilog_library` graph.
+
+    One `verilog_library` is created per module. The top module is `name` and
+    its `verilog_library` target is also called `name`, so the result can be
+    passed directly to `verilator_cc_library` or `verilator_lint_test`.
+
+    Args:
+        name (str): The name of the top level `verilog_library`.
+        modules (int): The total number of modules in the design.
+        depth (int): The number of levels in the instance hierarchy.
+        fanout (int): The number of child instances per non-leaf module.
+        width (int, optional): The data path width in bits.
+        stages (int, optional): The number of pipeline stages per module.
+        **kwargs: Additional keyword arguments applied to every generated target.
+    """
+    if modules < 1 or depth < 1 or fanout < 1:
+        fail("`modules`, `depth`, and `fanout` must be positive for {}".format(name))
+    if width < 4:
+        fail("`width` must be at least 4 for {}".format(name))
+    if stages < 1:
+        fail("`stages` must be positive for {}".format(name))
+
+    sizes = _level_sizes(modules, depth, fanout)
+
+    for level, size in enumerate(sizes):
+        for index in range(size):
+            module_name = name if level == 0 else _module_name(name, level, index)
+
+            children = []
+            if level + 1 < len(sizes):
+                child_count = sizes[level + 1]
+                for child in range(fanout):
+                    children.append(_module_name(name, level + 1, (index * fanout + child) % child_count))
+
+            _synthetic_verilog_module(
+                name = module_name + "_sv",
+                module_name = module_name,
+                children = children,
+                width = width,
+                stages = stages,
+                **kwargs
+            )
+
+            verilog_library(
+                name = module_name,
+                srcs = [":" + module_name + "_sv"],
+                deps = [":" + child for child in sorted({child: None for child in children}.keys())],
+                **kwargs
+            )
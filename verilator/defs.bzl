@@ -12,26 +12,61 @@ register_toolchain(
     "@rules_verilog//verilator/toolchain",
 )
 ```
+
+## Coverage
+
+Under `bazel coverage`, `verilator_cc_library` models are built with Verilator
+line, toggle, and user coverage and `VM_COVERAGE=1` is defined for dependents.
+Tests write the collected points into `$COVERAGE_DIR` and the
+`verilator_coverage_merger` converts them to LCOV. It is not registered by
+default, to use it add the following to your `.bazelrc`:
+
+```text
+coverage --coverage_output_generator=@rules_verilog//verilator:verilator_coverage_merger
+```
+
+This replaces Bazel's default LCOV merger for every test. Coverage from C++
+toolchains writing LCOV (e.g. `llvm-cov`) is still merged, but gcov based
+coverage is not.
+
+The merger also accepts LCOV tracefiles (e.g. from `llvm-cov`) and can be run
+directly on the `coverage.dat` files of many shards:
+
+```text
+bazel run @rules_verilog//verilator:verilator_coverage_merger -- --output_file=$PWD/merged.info shard_*/coverage.dat
+```
 """
 
+load(
+    "//verilator:verilator_binary.bzl",
+    _verilator_binary = "verilator_binary",
+)
 load(
     "//verilator:verilator_cc_library.bzl",
     _verilator_cc_library = "verilator_cc_library",
 )
 load(
     "//verilator:verilator_lint_aspect.bzl",
+    _verilator_fused_lint_aspect = "verilator_fused_lint_aspect",
     _verilator_lint_aspect = "verilator_lint_aspect",
 )
 load(
     "//verilator:verilator_lint_test.bzl",
     _verilator_lint_test = "verilator_lint_test",
 )
+load(
+    "//verilator:verilator_test.bzl",
+    _verilator_test = "verilator_test",
+)
 load(
     "//verilator:verilator_toolchain.bzl",
     _verilator_toolchain = "verilator_toolchain",
 )
 
+verilator_binary = _verilator_binary
 verilator_cc_library = _verilator_cc_library
+verilator_fused_lint_aspect = _verilator_fused_lint_aspect
 verilator_lint_aspect = _verilator_lint_aspect
 verilator_lint_test = _verilator_lint_test
+verilator_test = _verilator_test
 verilator_toolchain = _verilator_toolchain
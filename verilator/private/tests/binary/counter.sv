@@ -0,0 +1,11 @@
+module counter (
+    input  logic       clk,
+    input  logic       rst_n,
+    input  logic       enable,
+    output logic [7:0] count
+);
+    always_ff @(posedge clk or negedge rst_n) begin
+        if (!rst_n) count <= '0;
+        else if (enable) count <= count + 8'd1;
+    end
+endmodule
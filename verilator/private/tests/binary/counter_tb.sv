@@ -0,0 +1,33 @@
+module counter_tb;
+    logic       clk = 1'b0;
+    logic       rst_n = 1'b0;
+    logic       enable = 1'b0;
+    logic [7:0] count;
+
+    counter dut (
+        .clk   (clk),
+        .rst_n (rst_n),
+        .enable(enable),
+        .count (count)
+    );
+
+    always #5 clk = ~clk;
+
+    // Stimulus is driven on the falling edge to avoid racing the design.
+    initial begin
+        @(negedge clk);
+        if (count != 8'd0) $fatal(1, "Expected reset count of 0, got %0d", count);
+
+        rst_n  = 1'b1;
+        enable = 1'b1;
+        repeat (10) @(negedge clk);
+        enable = 1'b0;
+        if (count != 8'd10) $fatal(1, "Expected count of 10, got %0d", count);
+
+        repeat (3) @(negedge clk);
+        if (count != 8'd10) $fatal(1, "Count changed while disabled: %0d", count);
+
+        $display("All tests passed.");
+        $finish;
+    end
+endmodule
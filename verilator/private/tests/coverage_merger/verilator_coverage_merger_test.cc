@@ -0,0 +1,152 @@
+/**
+ * @file verilator_coverage_merger_test.cc
+ * @brief Checks that `verilator_coverage_merger` combines Verilator and LCOV
+ * inputs into the expected LCOV report.
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+using rules_cc::cc::runfiles::Runfiles;
+
+// Add support for Bazel 7
+#ifndef BAZEL_CURRENT_REPOSITORY
+#define BAZEL_CURRENT_REPOSITORY "_main"
+#endif
+
+/**
+ * @brief Reads the entire content of a file.
+ *
+ * @param path The file to read.
+ * @param output An output parameter for the file content.
+ * @return True if successful.
+ */
+bool read_file(const std::string& path, std::string& output) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open " << path << std::endl;
+        return false;
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    output = buffer.str();
+    return true;
+}
+
+/**
+ * @brief Runs the merger and compares its output to the expected report.
+ *
+ * @param cmd The merger command without `--output_file`.
+ * @param output The report to write.
+ * @param expected The expected content of the report.
+ * @return True if the merger succeeded and the report matches.
+ */
+bool check_merge(const std::string& cmd, const std::string& output,
+                 const std::string& expected) {
+    std::string full_cmd = cmd + " --output_file=" + output;
+    int result = std::system(full_cmd.c_str());
+    if (result != 0) {
+        std::cerr << "Merger failed: " << full_cmd << std::endl;
+        return false;
+    }
+
+    std::string actual = {};
+    if (!read_file(output, actual)) {
+        return false;
+    }
+
+    if (actual != expected) {
+        std::cerr << "Merged report does not match for: " << full_cmd
+                  << "\nExpected:\n"
+                  << expected << "\nActual:\n"
+                  << actual << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+int main() {
+    const char* merger_env = std::getenv("MERGER");
+    const char* inputs_env = std::getenv("INPUTS");
+    const char* expected_env = std::getenv("EXPECTED");
+    const char* tmp_dir_env = std::getenv("TEST_TMPDIR");
+
+    if (!merger_env || !inputs_env || !expected_env || !tmp_dir_env) {
+        std::cerr << "MERGER, INPUTS, EXPECTED and TEST_TMPDIR environment "
+                     "variables must be set."
+                  << std::endl;
+        return 1;
+    }
+
+    std::string error = {};
+    std::unique_ptr<Runfiles> runfiles(
+        Runfiles::CreateForTest(BAZEL_CURRENT_REPOSITORY, &error));
+
+    if (!error.empty()) {
+        std::cerr << "Error creating runfiles: " << error << std::endl;
+        return 1;
+    }
+
+    std::string merger = runfiles->Rlocation(merger_env);
+    std::string flags = " --jobs=2 --filter_sources=/usr/include/.+";
+
+    // Inputs passed on the command line, as when merging shards by hand.
+    std::string reports = std::string(tmp_dir_env) + "/reports.txt";
+    std::ofstream reports_file(reports, std::ios::binary);
+    std::string staged_reports = std::string(tmp_dir_env) + "/staged.txt";
+    std::ofstream staged_reports_file(staged_reports, std::ios::binary);
+    std::string cmd = merger + flags;
+    std::istringstream inputs(inputs_env);
+    std::string input = {};
+    int index = 0;
+    while (inputs >> input) {
+        cmd += " " + runfiles->Rlocation(input);
+        reports_file << runfiles->Rlocation(input) << "\n";
+
+        // Convert each input on its own, as Bazel does for every test.
+        std::string staged = std::string(tmp_dir_env) + "/staged_" +
+                             std::to_string(index++) + ".info";
+        std::string stage_cmd = merger + " --output_file=" + staged + " " +
+                                runfiles->Rlocation(input);
+        if (std::system(stage_cmd.c_str()) != 0) {
+            std::cerr << "Merger failed: " << stage_cmd << std::endl;
+            return 1;
+        }
+        staged_reports_file << staged << "\n";
+    }
+    reports_file.close();
+    staged_reports_file.close();
+
+    // Inputs listed in `--reports_file`, as Bazel does for the combined report.
+    std::string reports_cmd = merger + flags + " --reports_file=" + reports;
+
+    // Per-test reports combined again. Shards see different points on the
+    // same line, so this only matches if branch numbers identify points.
+    std::string staged_cmd =
+        merger + flags + " --reports_file=" + staged_reports;
+
+    std::string expected = {};
+    if (!read_file(runfiles->Rlocation(expected_env), expected)) {
+        return 1;
+    }
+
+    if (!check_merge(cmd, std::string(tmp_dir_env) + "/merged.info",
+                     expected) ||
+        !check_merge(reports_cmd,
+                     std::string(tmp_dir_env) + "/combined.info", expected) ||
+        !check_merge(staged_cmd, std::string(tmp_dir_env) + "/staged.info",
+                     expected)) {
+        return 1;
+    }
+
+    std::cout << "Merged reports match." << std::endl;
+    return 0;
+}
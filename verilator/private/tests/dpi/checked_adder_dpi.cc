@@ -0,0 +1,9 @@
+#include <cstdint>
+
+#include "Vchecked_adder__Dpi.h"
+#include "verilator/private/tests/dpi/reference_model.h"
+
+int reference_add(int a, int b) {
+    return static_cast<int>(reference_model::Add(static_cast<uint32_t>(a),
+                                                 static_cast<uint32_t>(b)));
+}
@@ -0,0 +1,58 @@
+#include <verilated.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+#include "Vchecked_adder.h"
+#include "verilator/private/tests/dpi/reference_model.h"
+
+namespace {
+
+bool RunTest() {
+    std::unique_ptr<Vchecked_adder> dut = std::make_unique<Vchecked_adder>();
+
+    const uint32_t inputs[][2] = {
+        {0, 0},
+        {1, 2},
+        {0xFFFFFFFF, 1},
+        {0x12345678, 0x9ABCDEF0},
+    };
+
+    bool success = true;
+    for (const uint32_t* input : inputs) {
+        dut->a = input[0];
+        dut->b = input[1];
+        dut->eval();
+
+        uint32_t expected = input[0] + input[1];
+        if (dut->sum != expected || dut->mismatch) {
+            std::cerr << "Test failed for " << input[0] << " + " << input[1]
+                      << ": sum " << dut->sum << ", mismatch "
+                      << (int)dut->mismatch << std::endl;
+            success = false;
+        }
+    }
+
+    if (reference_model::AddCalls() == 0) {
+        std::cerr << "Reference model was never called" << std::endl;
+        success = false;
+    }
+
+    return success;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+
+    if (RunTest()) {
+        std::cout << "All tests passed." << std::endl;
+        return 0;
+    } else {
+        std::cerr << "Some tests failed." << std::endl;
+        return 1;
+    }
+}
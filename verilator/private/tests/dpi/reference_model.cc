@@ -0,0 +1,18 @@
+#include "verilator/private/tests/dpi/reference_model.h"
+
+namespace reference_model {
+
+namespace {
+
+uint64_t add_calls = 0;
+
+}  // namespace
+
+uint32_t Add(uint32_t a, uint32_t b) {
+    ++add_calls;
+    return a + b;
+}
+
+uint64_t AddCalls() { return add_calls; }
+
+}  // namespace reference_model
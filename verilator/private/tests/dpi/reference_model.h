@@ -0,0 +1,20 @@
+#ifndef VERILATOR_PRIVATE_TESTS_DPI_REFERENCE_MODEL_H_
+#define VERILATOR_PRIVATE_TESTS_DPI_REFERENCE_MODEL_H_
+
+#include <cstdint>
+
+namespace reference_model {
+
+/**
+ * @brief The expected result of the adder.
+ */
+uint32_t Add(uint32_t a, uint32_t b);
+
+/**
+ * @brief The number of times `Add` has been called.
+ */
+uint64_t AddCalls();
+
+}  // namespace reference_model
+
+#endif  // VERILATOR_PRIVATE_TESTS_DPI_REFERENCE_MODEL_H_
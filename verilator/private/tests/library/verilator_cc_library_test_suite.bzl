@@ -0,0 +1,77 @@
+"""Starlark tests for `verilator_cc_library`."""
+
+load("@bazel_skylib//lib:unittest.bzl", "analysistest", "asserts")
+load("@rules_cc//cc/common:cc_info.bzl", "CcInfo")
+
+_DYNAMIC_LIBRARY_EXTENSIONS = ["dll", "dylib", "so"]
+
+def _dynamic_libraries(files):
+    return [file for file in files if file.extension in _DYNAMIC_LIBRARY_EXTENSIONS]
+
+def _linked_dynamic_libraries(target):
+    libraries = []
+    for linker_input in target[CcInfo].linking_context.linker_inputs.to_list():
+        for library in linker_input.libraries:
+            if library.dynamic_library and library.dynamic_library.owner == target.label:
+                libraries.append(library.dynamic_library)
+    return libraries
+
+def _shared_library_test_impl(ctx):
+    env = analysistest.begin(ctx)
+
+    target = analysistest.target_under_test(env)
+    files = target[DefaultInfo].files.to_list()
+    runfiles = target[DefaultInfo].default_runfiles.files.to_list()
+
+    asserts.equals(env, 1, len(_dynamic_libraries(files)), "Expected a dynamic library in the outputs")
+    asserts.equals(env, 1, len(_dynamic_libraries(runfiles)), "Expected the dynamic library in the runfiles")
+    asserts.equals(env, 1, len(_linked_dynamic_libraries(target)), "Expected dependents to link the dynamic library")
+
+    return analysistest.end(env)
+
+verilator_cc_library_shared_library_test = analysistest.make(
+    _shared_library_test_impl,
+)
+
+def _static_library_test_impl(ctx):
+    env = analysistest.begin(ctx)
+
+    target = analysistest.target_under_test(env)
+    files = target[DefaultInfo].files.to_list()
+
+    asserts.equals(env, [], _dynamic_libraries(files), "Expected no dynamic library in the outputs")
+    asserts.equals(env, [], _linked_dynamic_libraries(target), "Expected no dynamic library for dependents")
+
+    return analysistest.end(env)
+
+verilator_cc_library_static_library_test = analysistest.make(
+    _static_library_test_impl,
+)
+
+def verilator_cc_library_test_suite(*, name, static_library, shared_library, **kwargs):
+    """Tests for the libraries produced by `verilator_cc_library`.
+
+    Args:
+        name (str): The name of the test suite.
+        static_library (Label): A `verilator_cc_library` with the default `linkstatic = True`.
+        shared_library (Label): A `verilator_cc_library` with `linkstatic = False`.
+        **kwargs: Additional keyword arguments for the test suite.
+    """
+    verilator_cc_library_static_library_test(
+        name = name + "_static_library_test",
+        target_under_test = static_library,
+    )
+
+    verilator_cc_library_shared_library_test(
+        name = name + "_shared_library_test",
+        target_under_test = shared_library,
+    )
+
+    native.test_suite(
+        name = name,
+        tests = [
+            ":" + name + "_static_library_test",
+            ":" + name + "_shared_library_test",
+        ],
+        **kwargs
+    )
@@ -8,6 +8,12 @@
 
 #include "Vserial_to_parallel.h"
 
+#if VM_COVERAGE
+#include <verilated_cov.h>
+
+#include <string>
+#endif
+
 namespace {
 
 void Clock(Vserial_to_parallel* dut) {
@@ -17,6 +23,21 @@ void Clock(Vserial_to_parallel* dut) {
     dut->eval();
 }
 
+/**
+ * @brief Writes coverage collected by the model when running under
+ * `bazel coverage`. Must be called while the model is still alive.
+ */
+void WriteCoverage() {
+#if VM_COVERAGE
+    // Collected points are merged by `//verilator:verilator_coverage_merger`.
+    const char* coverage_dir = std::getenv("COVERAGE_DIR");
+    if (coverage_dir != nullptr) {
+        Verilated::threadContextp()->coveragep()->write(
+            std::string(coverage_dir) + "/serial_to_parallel.dat");
+    }
+#endif
+}
+
 void Reset(Vserial_to_parallel* dut) {
     dut->rst_n = 0;
     Clock(dut);
@@ -102,6 +123,8 @@ bool RunTest() {
         success = false;
     }
 
+    WriteCoverage();
+
     return success;
 }
 
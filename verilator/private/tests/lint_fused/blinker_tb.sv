@@ -0,0 +1,26 @@
+module blinker_tb;
+    logic clk;
+    logic rst_n;
+    logic led;
+
+    blinker dut (
+        .clk  (clk),
+        .rst_n(rst_n),
+        .led  (led)
+    );
+
+    initial begin
+        clk = 1'b0;
+        forever #5 clk = ~clk;
+    end
+
+    // Timing constructs are only accepted by lint with `--timing`.
+    initial begin
+        rst_n = 1'b0;
+        @(negedge clk);
+        rst_n = 1'b1;
+        @(negedge clk);
+        if (led != 1'b1) $fatal(1, "Expected led to toggle");
+        $finish;
+    end
+endmodule
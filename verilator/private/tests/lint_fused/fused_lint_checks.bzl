@@ -0,0 +1,36 @@
+"""Build targets as `--config=verilator_lint_fused` would."""
+
+load("//verilator/private:verilator_lint.bzl", "verilator_fused_lint_aspect")
+
+_FUSE_LINT = str(Label("//verilator/settings:fuse_lint"))
+
+def _fuse_lint_transition_impl(_settings, _attr):
+    return {_FUSE_LINT: True}
+
+_fuse_lint_transition = transition(
+    implementation = _fuse_lint_transition_impl,
+    inputs = [],
+    outputs = [_FUSE_LINT],
+)
+
+def _fused_lint_checks_impl(ctx):
+    files = []
+    for target in ctx.attr.targets:
+        files.append(target[DefaultInfo].files)
+        if OutputGroupInfo in target and hasattr(target[OutputGroupInfo], "verilator_lint_check"):
+            files.append(target[OutputGroupInfo].verilator_lint_check)
+
+    return [DefaultInfo(files = depset(transitive = files))]
+
+fused_lint_checks = rule(
+    doc = "Collects the outputs and `verilator_lint_check` output group of targets built with `fuse_lint` enabled.",
+    implementation = _fused_lint_checks_impl,
+    attrs = {
+        "targets": attr.label_list(
+            doc = "The targets to build and lint.",
+            mandatory = True,
+            cfg = _fuse_lint_transition,
+            aspects = [verilator_fused_lint_aspect],
+        ),
+    },
+)
@@ -0,0 +1,85 @@
+"""Starlark tests for fusing lint into the Verilate action."""
+
+load("@bazel_skylib//lib:unittest.bzl", "analysistest", "asserts")
+load("//verilator/private:verilator_lint.bzl", "verilator_fused_lint_aspect", "verilator_lint_aspect")
+
+_FUSE_LINT = str(Label("//verilator/settings:fuse_lint"))
+
+def _mnemonics(env):
+    return [action.mnemonic for action in analysistest.target_actions(env)]
+
+def _fused_lint_test_impl(ctx):
+    env = analysistest.begin(ctx)
+
+    target = analysistest.target_under_test(env)
+    checks = target[OutputGroupInfo].verilator_lint_check.to_list()
+
+    asserts.equals(env, 1, len(checks), "Expected exactly one lint check")
+    asserts.true(
+        env,
+        checks[0].short_path.endswith("/{}_V/verilator_lint.ok".format(target.label.name)),
+        "Expected the lint check of the Verilate action, got {}".format(checks[0].short_path),
+    )
+
+    mnemonics = _mnemonics(env)
+    asserts.false(env, "VerilatorLint" in mnemonics, "Expected no standalone lint action")
+
+    verilate = [action for action in analysistest.target_actions(env) if action.mnemonic == "Verilate"]
+    asserts.equals(env, 1, len(verilate), "Expected a single Verilate action")
+    asserts.true(env, checks[0] in verilate[0].outputs.to_list(), "Expected Verilate to produce the lint check")
+
+    return analysistest.end(env)
+
+verilator_fused_lint_test = analysistest.make(
+    _fused_lint_test_impl,
+    extra_target_under_test_aspects = [verilator_fused_lint_aspect],
+    config_settings = {_FUSE_LINT: True},
+)
+
+def _standalone_lint_test_impl(ctx):
+    env = analysistest.begin(ctx)
+
+    target = analysistest.target_under_test(env)
+    checks = target[OutputGroupInfo].verilator_lint_check.to_list()
+
+    asserts.equals(env, 1, len(checks), "Expected exactly one lint check")
+    asserts.equals(env, "{}.verilator_lint.ok".format(target.label.name), checks[0].basename)
+
+    # The default lint path must not pay for verilation.
+    mnemonics = _mnemonics(env)
+    asserts.true(env, "VerilatorLint" in mnemonics, "Expected a standalone lint action")
+    asserts.false(env, "Verilate" in mnemonics, "Expected no Verilate action")
+
+    return analysistest.end(env)
+
+verilator_standalone_lint_test = analysistest.make(
+    _standalone_lint_test_impl,
+    extra_target_under_test_aspects = [verilator_lint_aspect],
+)
+
+def fused_lint_test_suite(*, name, module, **kwargs):
+    """Tests which lint action provides the `verilator_lint_check` output group.
+
+    Args:
+        name (str): The name of the test suite.
+        module (Label): A `verilog_library` to lint.
+        **kwargs: Additional keyword arguments for the test suite.
+    """
+    verilator_fused_lint_test(
+        name = name + "_fused_lint_test",
+        target_under_test = module,
+    )
+
+    verilator_standalone_lint_test(
+        name = name + "_standalone_lint_test",
+        target_under_test = module,
+    )
+
+    native.test_suite(
+        name = name,
+        tests = [
+            ":" + name + "_fused_lint_test",
+            ":" + name + "_standalone_lint_test",
+        ],
+        **kwargs
+    )
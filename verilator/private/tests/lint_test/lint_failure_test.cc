@@ -0,0 +1,108 @@
+/**
+ * @file lint_failure_test.cc
+ * @brief Checks that a `verilator_lint_test` for a module failing lint fails
+ * with the recorded exit code and prints Verilator's diagnostics.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#else
+#define popen _popen
+#define pclose _pclose
+#endif
+
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+using rules_cc::cc::runfiles::Runfiles;
+
+// Add support for Bazel 7
+#ifndef BAZEL_CURRENT_REPOSITORY
+#define BAZEL_CURRENT_REPOSITORY "_main"
+#endif
+
+/**
+ * @brief Runs a command, capturing its combined output.
+ *
+ * @param cmd The command to run.
+ * @param output An output parameter for the captured output.
+ * @return The exit code of the command.
+ */
+int run(const std::string& cmd, std::string& output) {
+    std::string full_cmd = cmd + " 2>&1";
+    FILE* pipe = popen(full_cmd.c_str(), "r");
+    if (!pipe) {
+        std::cerr << "Failed to run " << cmd << std::endl;
+        return -1;
+    }
+
+    char buffer[256];
+    while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
+        output += buffer;
+    }
+
+    int status = pclose(pipe);
+#ifdef _WIN32
+    return status;
+#else
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#endif
+}
+
+int main() {
+    const char* lint_test_env = std::getenv("LINT_TEST");
+    if (!lint_test_env) {
+        std::cerr << "LINT_TEST environment variable must be set." << std::endl;
+        return 1;
+    }
+
+    std::string error = {};
+    std::unique_ptr<Runfiles> runfiles(
+        Runfiles::CreateForTest(BAZEL_CURRENT_REPOSITORY, &error));
+
+    if (!error.empty()) {
+        std::cerr << "Error creating runfiles: " << error << std::endl;
+        return 1;
+    }
+
+    // `verilator_lint_test` records its result next to the test executable.
+    std::string lint_result = std::string(lint_test_env) + ".verilator_lint.txt";
+    std::ifstream result_file(runfiles->Rlocation(lint_result));
+    int recorded = 0;
+    if (!(result_file >> recorded)) {
+        std::cerr << "Failed to read lint result: " << lint_result
+                  << std::endl;
+        return 1;
+    }
+
+#ifdef _WIN32
+    _putenv_s("RULES_VERILOG_VERILATOR_LINT_RESULT", lint_result.c_str());
+#else
+    setenv("RULES_VERILOG_VERILATOR_LINT_RESULT", lint_result.c_str(), 1);
+#endif
+
+    std::string output = {};
+    int result = run(runfiles->Rlocation(lint_test_env), output);
+
+    if (recorded == 0 || result != recorded) {
+        std::cerr << "Expected lint to fail with the recorded exit code "
+                  << recorded << ", got " << result << std::endl;
+        return 1;
+    }
+
+    if (output.find("UNUSEDSIGNAL") == std::string::npos ||
+        output.find("unused_input.sv") == std::string::npos) {
+        std::cerr << "Expected lint diagnostics in the test output, got:\n"
+                  << output << std::endl;
+        return 1;
+    }
+
+    std::cout << "Lint failure was reported." << std::endl;
+    return 0;
+}
@@ -0,0 +1,8 @@
+module unused_input (
+    input  logic a,
+    input  logic b,
+    output logic y
+);
+    // `b` is never read, which `-Wall` reports as `UNUSEDSIGNAL`.
+    assign y = a;
+endmodule
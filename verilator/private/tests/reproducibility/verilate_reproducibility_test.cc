@@ -0,0 +1,222 @@
+/**
+ * @file verilate_reproducibility_test.cc
+ * @brief Checks that Verilate outputs of the same module are byte-for-byte
+ * identical when built in different output directories and when verilated
+ * from different exec roots.
+ */
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "rules_cc/cc/runfiles/runfiles.h"
+
+namespace fs = std::filesystem;
+
+using rules_cc::cc::runfiles::Runfiles;
+
+// Add support for Bazel 7
+#ifndef BAZEL_CURRENT_REPOSITORY
+#define BAZEL_CURRENT_REPOSITORY "_main"
+#endif
+
+/**
+ * @brief Splits a space separated list of runfiles paths.
+ *
+ * @param text The list to split.
+ * @return The individual paths.
+ */
+std::vector<std::string> split(const std::string& text) {
+    std::vector<std::string> parts;
+    std::istringstream stream(text);
+    std::string part = {};
+    while (stream >> part) {
+        parts.push_back(part);
+    }
+    return parts;
+}
+
+/**
+ * @brief Reads the entire content of a file.
+ *
+ * @param path The file to read.
+ * @return The file content.
+ */
+std::string read_file(const fs::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+/**
+ * @brief Lists the files in a directory relative to it.
+ *
+ * @param dir The directory to list.
+ * @return The sorted relative paths of all regular files.
+ */
+std::set<std::string> list_files(const fs::path& dir) {
+    std::set<std::string> files;
+    for (const fs::directory_entry& entry :
+         fs::recursive_directory_iterator(dir)) {
+        if (entry.is_regular_file()) {
+            files.insert(fs::relative(entry.path(), dir).generic_string());
+        }
+    }
+    return files;
+}
+
+/**
+ * @brief Compares two directories of generated files.
+ *
+ * @param first The first directory.
+ * @param second The second directory.
+ * @return True if both contain the same files with identical content.
+ */
+bool compare_dirs(const fs::path& first, const fs::path& second) {
+    std::set<std::string> first_files = list_files(first);
+    std::set<std::string> second_files = list_files(second);
+
+    if (first_files.empty()) {
+        std::cerr << "No generated files found in " << first << std::endl;
+        return false;
+    }
+
+    if (first_files != second_files) {
+        std::cerr << "File lists differ between " << first << " and "
+                  << second << std::endl;
+        return false;
+    }
+
+    bool success = true;
+    for (const std::string& file : first_files) {
+        std::string first_content = read_file(first / file);
+        std::string second_content = read_file(second / file);
+        if (first_content != second_content) {
+            std::cerr << "Content differs: " << file << "\n--- " << first
+                      << "\n"
+                      << first_content << "\n+++ " << second << "\n"
+                      << second_content << std::endl;
+            success = false;
+        }
+    }
+
+    return success;
+}
+
+/**
+ * @brief Verilates a source with the process wrapper from a new exec root.
+ *
+ * The source is copied into the exec root and passed to Verilator by
+ * absolute path, so only the wrapper's exec root stripping keeps the
+ * location of the exec root out of the generated files.
+ *
+ * @param exec_root The directory to create and verilate in.
+ * @param wrapper The process wrapper binary.
+ * @param verilator The Verilator binary.
+ * @param source The Verilog source to verilate.
+ * @return True if verilation succeeded.
+ */
+bool verilate_in(const fs::path& exec_root, const std::string& wrapper,
+                 const std::string& verilator, const std::string& source) {
+    fs::create_directories(exec_root / "src");
+    fs::path src = exec_root / "src" / "parity.sv";
+    fs::copy_file(source, src, fs::copy_options::overwrite_existing);
+
+    std::string cmd = wrapper + " --verilator=" + verilator +
+                      " --src=" + src.string() + " --output=out" +
+                      " --output_srcs=out/srcs --output_hdrs=out/hdrs" +
+                      " --capture_output --" +
+                      " --no-std --cc --hierarchical --Mdir out" +
+                      " --top-module parity --prefix Vparity " + src.string();
+
+    fs::path cwd = fs::current_path();
+    fs::current_path(exec_root);
+    int result = std::system(cmd.c_str());
+    fs::current_path(cwd);
+
+    if (result != 0) {
+        std::cerr << "Verilate failed in " << exec_root << ": " << cmd
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main() {
+    const char* first_env = std::getenv("FIRST");
+    const char* second_env = std::getenv("SECOND");
+    const char* wrapper_env = std::getenv("WRAPPER");
+    const char* verilator_env = std::getenv("VERILATOR");
+    const char* source_env = std::getenv("SOURCE");
+    const char* tmp_dir_env = std::getenv("TEST_TMPDIR");
+
+    if (!first_env || !second_env || !wrapper_env || !verilator_env ||
+        !source_env || !tmp_dir_env) {
+        std::cerr << "FIRST, SECOND, WRAPPER, VERILATOR, SOURCE and "
+                     "TEST_TMPDIR environment variables must be set."
+                  << std::endl;
+        return 1;
+    }
+
+    std::string error = {};
+    std::unique_ptr<Runfiles> runfiles(
+        Runfiles::CreateForTest(BAZEL_CURRENT_REPOSITORY, &error));
+
+    if (!error.empty()) {
+        std::cerr << "Error creating runfiles: " << error << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> first_dirs = split(first_env);
+    std::vector<std::string> second_dirs = split(second_env);
+    if (first_dirs.empty() || first_dirs.size() != second_dirs.size()) {
+        std::cerr << "Mismatched outputs: " << first_env << " vs "
+                  << second_env << std::endl;
+        return 1;
+    }
+
+    bool success = true;
+    for (size_t i = 0; i < first_dirs.size(); ++i) {
+        if (first_dirs[i] == second_dirs[i]) {
+            std::cerr << "Outputs were not built in distinct directories: "
+                      << first_dirs[i] << std::endl;
+            return 1;
+        }
+
+        success &= compare_dirs(runfiles->Rlocation(first_dirs[i]),
+                                runfiles->Rlocation(second_dirs[i]));
+    }
+
+    // Exec roots of different lengths so a leaked path cannot line up.
+    fs::path tmp_dir = fs::absolute(tmp_dir_env);
+    fs::path first_root = tmp_dir / "exec_root_a";
+    fs::path second_root = tmp_dir / "nested" / "exec_root_b";
+    std::string wrapper = fs::absolute(runfiles->Rlocation(wrapper_env)).string();
+    std::string verilator =
+        fs::absolute(runfiles->Rlocation(verilator_env)).string();
+    std::string source = runfiles->Rlocation(source_env);
+
+    if (!verilate_in(first_root, wrapper, verilator, source) ||
+        !verilate_in(second_root, wrapper, verilator, source)) {
+        return 1;
+    }
+
+    success &= compare_dirs(first_root / "out" / "srcs",
+                            second_root / "out" / "srcs");
+    success &= compare_dirs(first_root / "out" / "hdrs",
+                            second_root / "out" / "hdrs");
+
+    if (!success) {
+        return 1;
+    }
+
+    std::cout << "Verilate outputs are identical." << std::endl;
+    return 0;
+}
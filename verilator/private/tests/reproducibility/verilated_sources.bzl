@@ -0,0 +1,52 @@
+"""Expose the Verilate outputs of a module built in a given compilation mode."""
+
+load("//verilator/private:verilator_cc.bzl", "VerilatorCcInfo", "verilator_cc_aspect")
+
+def _compilation_mode_transition_impl(_settings, attr):
+    return {"//command_line_option:compilation_mode": attr.compilation_mode}
+
+_compilation_mode_transition = transition(
+    implementation = _compilation_mode_transition_impl,
+    inputs = [],
+    outputs = ["//command_line_option:compilation_mode"],
+)
+
+def _verilated_sources_impl(ctx):
+    module = ctx.attr.module
+    if type(module) == "list":
+        module = module[0]
+
+    # The generated directories have the same runfiles path in every
+    # configuration, so expose them under a location unique to this target.
+    info = module[VerilatorCcInfo]
+    outputs = []
+    for tree in [info.srcs_dir, info.hdrs_dir]:
+        output = ctx.actions.declare_directory("{}/{}".format(ctx.label.name, tree.basename))
+        ctx.actions.symlink(
+            output = output,
+            target_file = tree,
+        )
+        outputs.append(output)
+
+    return [DefaultInfo(
+        files = depset(outputs),
+        runfiles = ctx.runfiles(files = outputs),
+    )]
+
+verilated_sources = rule(
+    doc = "Collects the generated C++ of a module verilated in a distinct output directory.",
+    implementation = _verilated_sources_impl,
+    attrs = {
+        "compilation_mode": attr.string(
+            doc = "The compilation mode, and therefore output directory, to verilate in.",
+            values = ["dbg", "fastbuild", "opt"],
+            mandatory = True,
+        ),
+        "module": attr.label(
+            doc = "The Verilog module to verilate.",
+            mandatory = True,
+            cfg = _compilation_mode_transition,
+            aspects = [verilator_cc_aspect],
+        ),
+    },
+)
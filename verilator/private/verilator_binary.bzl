@@ -0,0 +1,218 @@
+"""Verilator binary rules."""
+
+load("@rules_cc//cc:find_cc_toolchain.bzl", "find_cpp_toolchain")
+load("@rules_cc//cc/common:cc_common.bzl", "cc_common")
+load("@rules_cc//cc/common:cc_info.bzl", "CcInfo")
+load("//verilog:verilog_info.bzl", "VerilogInfo")
+load(":verilator_utils.bzl", "collect_transitive_verilog_sources")
+
+def _verilator_binary_impl(ctx):
+    verilator_toolchain = ctx.toolchains["//verilator:toolchain_type"]
+
+    module_info = ctx.attr.module[VerilogInfo]
+    module_name, _, _ = module_info.top.basename.partition(".")
+
+    direct_srcs, includes, inputs = collect_transitive_verilog_sources(module_info)
+
+    output_src_dir = ctx.actions.declare_directory("{}_V/srcs".format(ctx.label.name))
+    output_hdr_dir = ctx.actions.declare_directory("{}_V/hdrs".format(ctx.label.name))
+    output_dir = output_src_dir.dirname
+
+    # Build verilator compile command
+    args = ctx.actions.args()
+    args.add(verilator_toolchain.verilator, format = "--verilator=%s")
+    args.add_all(direct_srcs, format_each = "--src=%s")
+    args.add(output_dir, format = "--output=%s")
+    args.add(output_src_dir.path, format = "--output_srcs=%s")
+    args.add(output_hdr_dir.path, format = "--output_hdrs=%s")
+
+    # Keep generated sources independent of the output directory.
+    args.add("{}/=".format(ctx.bin_dir.path), format = "--path_prefix_map=%s")
+    args.add("--capture_output")
+
+    # Add delimiter before verilator arguments
+    args.add("--")
+
+    # Add verilator flags. `--main --timing` is `--binary` without `--build`,
+    # the generated sources are instead compiled and linked with the C++ toolchain.
+    args.add("--no-std")
+    args.add("--cc")
+    args.add("--main")
+    args.add("--timing")
+    if ctx.attr.threads > 0:
+        args.add("--threads", str(ctx.attr.threads))
+    args.add("--Mdir", output_dir)
+    args.add("--top-module", module_name)
+    args.add("--prefix", "V" + module_name)
+    args.add_all(includes, format_each = "-I%s")
+    args.add_all(verilator_toolchain.vopts)
+    args.add_all(ctx.attr.vopts)
+
+    # Add verilog files
+    args.add_all(direct_srcs)
+
+    ctx.actions.run(
+        mnemonic = "Verilate",
+        executable = ctx.executable._verilator_process_wrapper,
+        arguments = [args],
+        tools = verilator_toolchain.all_files,
+        inputs = inputs,
+        outputs = [output_src_dir, output_hdr_dir],
+    )
+
+    cc_toolchain = find_cpp_toolchain(ctx)
+    feature_configuration = cc_common.configure_features(
+        ctx = ctx,
+        cc_toolchain = cc_toolchain,
+        requested_features = ctx.features,
+        unsupported_features = ctx.disabled_features,
+    )
+
+    compilation_contexts = [verilator_toolchain.libverilator[CcInfo].compilation_context]
+    linking_contexts = [verilator_toolchain.libverilator[CcInfo].linking_context]
+
+    for dep in verilator_toolchain.deps + ctx.attr.deps:
+        compilation_contexts.append(dep[CcInfo].compilation_context)
+        linking_contexts.append(dep[CcInfo].linking_context)
+
+    # The timing scheduler is implemented with C++20 coroutines.
+    windows_constraint = ctx.attr._windows_constraint[platform_common.ConstraintValueInfo]
+    if ctx.target_platform_has_constraint(windows_constraint):
+        timing_copts = ["/std:c++20"]
+    else:
+        timing_copts = ["-std=c++20"]
+
+    _compilation_context, compilation_outputs = cc_common.compile(
+        name = ctx.label.name,
+        actions = ctx.actions,
+        feature_configuration = feature_configuration,
+        cc_toolchain = cc_toolchain,
+        user_compile_flags = verilator_toolchain.copts + timing_copts + ctx.attr.copts,
+        srcs = [output_src_dir],
+        includes = [output_hdr_dir.path, output_src_dir.path],
+        private_hdrs = [output_hdr_dir],
+        compilation_contexts = compilation_contexts,
+    )
+
+    linking_outputs = cc_common.link(
+        name = ctx.label.name,
+        actions = ctx.actions,
+        feature_configuration = feature_configuration,
+        cc_toolchain = cc_toolchain,
+        compilation_outputs = compilation_outputs,
+        linking_contexts = linking_contexts,
+        user_link_flags = verilator_toolchain.linkopts + ctx.attr.linkopts,
+        output_type = "executable",
+    )
+
+    return [
+        DefaultInfo(
+            executable = linking_outputs.executable,
+            runfiles = ctx.runfiles(files = ctx.files.data),
+        ),
+    ]
+
+_COMMON_ATTRS = {
+    "copts": attr.string_list(
+        doc = "List of additional C++ compiler flags for the generated sources.",
+        default = [],
+    ),
+    "data": attr.label_list(
+        doc = "Data used at runtime by the binary.",
+        allow_files = True,
+    ),
+    "deps": attr.label_list(
+        doc = "Additional C++ libraries to link into the binary.",
+        providers = [CcInfo],
+    ),
+    "linkopts": attr.string_list(
+        doc = "List of additional C++ linker flags",
+        default = [],
+    ),
+    "module": attr.label(
+        doc = "The top level Verilog module (usually a testbench) to build.",
+        providers = [VerilogInfo],
+        mandatory = True,
+    ),
+    "threads": attr.int(
+        doc = "The number of threads to simulate with (`--threads`). `0` builds a single threaded model.",
+        default = 0,
+    ),
+    "vopts": attr.string_list(
+        doc = "List of additional flags to pass to Verilator.",
+        default = [],
+    ),
+    "_verilator_process_wrapper": attr.label(
+        doc = "The Verilator process wrapper binary.",
+        cfg = "exec",
+        executable = True,
+        default = Label("//verilator/private:verilator_process_wrapper"),
+    ),
+    "_windows_constraint": attr.label(
+        default = Label("@platforms//os:windows"),
+    ),
+}
+
+verilator_binary = rule(
+    doc = """Builds a native simulation executable from a SystemVerilog top module.
+
+    The module is verilated with `--main --timing` so Verilator's own scheduler
+    drives simulation time, and no C++ harness is required. Delays, `@` event
+    controls, and `$finish` in the top module work as they would in any other
+    simulator.
+
+    Example:
+
+    ```python
+    verilog_library(
+        name = "my_module_tb",
+        srcs = ["my_module_tb.sv"],
+        deps = [":my_module"],
+    )
+
+    verilator_binary(
+        name = "my_module_sim",
+        module = ":my_module_tb",
+    )
+    ```
+    """,
+    implementation = _verilator_binary_impl,
+    attrs = _COMMON_ATTRS,
+    executable = True,
+    toolchains = [
+        "@rules_cc//cc:toolchain_type",
+        "//verilator:toolchain_type",
+    ],
+    fragments = ["cpp"],
+)
+
+verilator_test = rule(
+    doc = """Runs a SystemVerilog testbench as a test.
+
+    This is the test equivalent of `verilator_binary`. The test fails if the
+    simulation exits with a non-zero status, e.g. through `$fatal` or `$stop`.
+
+    Example:
+
+    ```python
+    verilog_library(
+        name = "my_module_tb",
+        srcs = ["my_module_tb.sv"],
+        deps = [":my_module"],
+    )
+
+    verilator_test(
+        name = "my_module_test",
+        module = ":my_module_tb",
+    )
+    ```
+    """,
+    implementation = _verilator_binary_impl,
+    attrs = _COMMON_ATTRS,
+    test = True,
+    toolchains = [
+        "@rules_cc//cc:toolchain_type",
+        "//verilator:toolchain_type",
+    ],
+    fragments = ["cpp"],
+)
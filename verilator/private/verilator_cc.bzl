@@ -1,9 +1,11 @@
 """Verilator Cc Rules."""
 
+load("@bazel_skylib//rules:common_settings.bzl", "BuildSettingInfo")
 load("@rules_cc//cc:find_cc_toolchain.bzl", "find_cpp_toolchain")
 load("@rules_cc//cc/common:cc_common.bzl", "cc_common")
 load("@rules_cc//cc/common:cc_info.bzl", "CcInfo")
 load("//verilog:verilog_info.bzl", "VerilogInfo")
+load(":verilator_utils.bzl", "verilator_lint_enabled")
 
 VerilatorCcInfo = provider(
     doc = "Provider for Verilator-compiled C++ outputs.",
@@ -11,6 +13,7 @@ VerilatorCcInfo = provider(
         "compilation_context": "CcCompilationContext with headers and includes",
         "compilation_outputs": "CcCompilationOutputs with object files",
         "hdrs_dir": "Directory containing generated C++ header files",
+        "lint_check": "File: A `.verilator_lint.ok` marker produced by the Verilate action, or None if lint is not fused.",
         "module_name": "Name of the Verilog module",
         "srcs_dir": "Directory containing generated C++ source files",
     },
@@ -25,9 +28,9 @@ def _verilator_cc_aspect_impl(target, ctx):
 
     # Only process targets with VerilogInfo
     if VerilogInfo not in target:
-        fail("`_verilator_cc_aspect` can only run on targets with `VerilogInfo` providers. Provider not found on: {}".format(target.label))
+        return []
 
-    # Only process targets with VerilogInfo
+    # Skip targets which already provide VerilatorCcInfo
     if VerilatorCcInfo in target:
         return []
 
@@ -61,6 +64,18 @@ def _verilator_cc_aspect_impl(target, ctx):
     output_hdr_dir = ctx.actions.declare_directory("{}_V/hdrs".format(label_name))
     output_dir = output_src_dir.dirname
 
+    # When lint is fused into verilation, the Verilate action adds the warning and
+    # timing flags of the standalone lint action (`-Wall --timing`) so it fails on
+    # any lint warning and the wrapper touches the lint marker on success. Unlike
+    # `--lint-only`, only modules below `--top-module` are elaborated and linted.
+    lint_check = None
+    outputs = [output_src_dir, output_hdr_dir]
+    env = {}
+    if ctx.attr._fuse_lint[BuildSettingInfo].value and verilator_lint_enabled(target, ctx):
+        lint_check = ctx.actions.declare_file("{}_V/verilator_lint.ok".format(label_name))
+        outputs.append(lint_check)
+        env["RULES_VERILOG_VERILATOR_LINT_OUTPUT"] = lint_check.path
+
     # Build verilator compile command
     args = ctx.actions.args()
     args.add(verilator_toolchain.verilator, format = "--verilator=%s")
@@ -68,6 +83,10 @@ def _verilator_cc_aspect_impl(target, ctx):
     args.add(output_dir, format = "--output=%s")
     args.add(output_src_dir.path, format = "--output_srcs=%s")
     args.add(output_hdr_dir.path, format = "--output_hdrs=%s")
+
+    # Strip the configuration specific output prefix from generated sources
+    # so they are identical across configurations and hit the remote cache.
+    args.add("{}/=".format(ctx.bin_dir.path), format = "--path_prefix_map=%s")
     args.add("--capture_output")
 
     # Add delimiter before verilator arguments
@@ -81,6 +100,17 @@ def _verilator_cc_aspect_impl(target, ctx):
     args.add("--top-module", module_name)
     args.add("--prefix", "V" + module_name)
     args.add_all(includes, format_each = "-I%s")
+    if lint_check:
+        args.add("--timing")
+        args.add("-Wall")
+
+    # Instrument the model when running under `bazel coverage`.
+    coverage_enabled = ctx.configuration.coverage_enabled and ctx.coverage_instrumented(target)
+    if coverage_enabled:
+        args.add("--coverage-line")
+        args.add("--coverage-toggle")
+        args.add("--coverage-user")
+
     args.add_all(verilator_toolchain.vopts)
 
     # Add verilog files
@@ -93,7 +123,8 @@ def _verilator_cc_aspect_impl(target, ctx):
         arguments = [args],
         tools = verilator_toolchain.all_files,
         inputs = inputs,
-        outputs = [output_src_dir, output_hdr_dir],
+        outputs = outputs,
+        env = env,
     )
 
     # Compile the C++ code to object files (no linking)
@@ -127,6 +158,7 @@ def _verilator_cc_aspect_impl(target, ctx):
         includes = [output_hdr_dir.path, output_src_dir.path],
         public_hdrs = [output_hdr_dir],
         compilation_contexts = compilation_contexts,
+        defines = ["VM_COVERAGE=1"] if coverage_enabled else [],
     )
 
     return [
@@ -135,15 +167,21 @@ def _verilator_cc_aspect_impl(target, ctx):
             compilation_outputs = compilation_outputs,
             srcs_dir = output_src_dir,
             hdrs_dir = output_hdr_dir,
+            lint_check = lint_check,
             module_name = module_name,
         ),
     ]
 
-_verilator_cc_aspect = aspect(
+verilator_cc_aspect = aspect(
     implementation = _verilator_cc_aspect_impl,
     doc = "Aspect for compiling Verilog modules to C++ object files with Verilator.",
     attr_aspects = ["deps"],
+    required_providers = [VerilogInfo],
     attrs = {
+        "_fuse_lint": attr.label(
+            doc = "Whether or not to lint as part of the Verilate action.",
+            default = Label("//verilator/settings:fuse_lint"),
+        ),
         "_verilator_process_wrapper": attr.label(
             doc = "The Verilator process wrapper binary.",
             cfg = "exec",
@@ -181,12 +219,6 @@ def _verilator_cc_library_impl(ctx):
         compilation_contexts.append(dep[CcInfo].compilation_context)
         linking_contexts.append(dep[CcInfo].linking_context)
 
-    # Merge all compilation outputs
-    merged_compilation_outputs = cc_common.merge_compilation_outputs(
-        compilation_outputs = all_compilation_outputs,
-    )
-
-    # Link everything together
     cc_toolchain = find_cpp_toolchain(ctx)
     feature_configuration = cc_common.configure_features(
         ctx = ctx,
@@ -195,6 +227,33 @@ def _verilator_cc_library_impl(ctx):
         unsupported_features = ctx.disabled_features,
     )
 
+    # DPI implementations are compiled against the generated `V<module>__Dpi.h`
+    # and `svdpi.h`. Their dependencies stay private to the model library.
+    dpi_compilation_contexts = []
+    for dep in ctx.attr.dpi_deps:
+        dpi_compilation_contexts.append(dep[CcInfo].compilation_context)
+        linking_contexts.append(dep[CcInfo].linking_context)
+
+    dpi_hdrs = [src for src in ctx.files.dpi_srcs if src.extension in ["h", "hh", "hpp"]]
+    dpi_srcs = [src for src in ctx.files.dpi_srcs if src not in dpi_hdrs]
+    if dpi_srcs:
+        _dpi_compilation_context, dpi_compilation_outputs = cc_common.compile(
+            name = ctx.label.name + "_dpi",
+            actions = ctx.actions,
+            feature_configuration = feature_configuration,
+            cc_toolchain = cc_toolchain,
+            user_compile_flags = verilator_toolchain.copts,
+            srcs = dpi_srcs,
+            private_hdrs = dpi_hdrs,
+            compilation_contexts = compilation_contexts + dpi_compilation_contexts,
+        )
+        all_compilation_outputs.append(dpi_compilation_outputs)
+
+    # Merge all compilation outputs
+    merged_compilation_outputs = cc_common.merge_compilation_outputs(
+        compilation_outputs = all_compilation_outputs,
+    )
+
     # Create linking context from all the compiled objects
     linking_context, linking_output = cc_common.create_linking_context_from_compilation_outputs(
         actions = ctx.actions,
@@ -204,7 +263,7 @@ def _verilator_cc_library_impl(ctx):
         linking_contexts = linking_contexts,
         name = ctx.label.name,
         user_link_flags = verilator_toolchain.linkopts + ctx.attr.linkopts,
-        disallow_dynamic_library = True,
+        disallow_dynamic_library = ctx.attr.linkstatic,
     )
 
     # Merge compilation contexts
@@ -218,15 +277,25 @@ def _verilator_cc_library_impl(ctx):
     if linking_output.library_to_link.pic_static_library != None:
         output_files.append(linking_output.library_to_link.pic_static_library)
 
+    # Shared libraries are needed at runtime by anything linking against the model.
+    runfiles_files = list(ctx.files.data)
+    if linking_output.library_to_link.dynamic_library != None:
+        output_files.append(linking_output.library_to_link.dynamic_library)
+        runfiles_files.append(linking_output.library_to_link.dynamic_library)
+
     return [
         DefaultInfo(
             files = depset(output_files),
-            runfiles = ctx.runfiles(files = ctx.files.data),
+            runfiles = ctx.runfiles(files = runfiles_files),
         ),
         CcInfo(
             compilation_context = merged_compilation_context,
             linking_context = linking_context,
         ),
+        coverage_common.instrumented_files_info(
+            ctx,
+            dependency_attributes = ["module"],
+        ),
     ]
 
 verilator_cc_library = rule(
@@ -234,7 +303,14 @@ verilator_cc_library = rule(
 
     This rule uses an aspect to compile each Verilog module in the dependency tree
     to C++ object files using Verilator's hierarchical compilation mode, then links
-    them all together into a single static library.
+    them all together into a single static library, or additionally a shared
+    library with `linkstatic = False`.
+
+    Under `bazel coverage` the model is verilated with line, toggle, and user
+    coverage and `VM_COVERAGE=1` is defined for dependents. Tests are expected to
+    write the collected points into `$COVERAGE_DIR`, e.g.
+    `Verilated::threadContextp()->coveragep()->write(...)`, where they are merged
+    by `//verilator:verilator_coverage_merger`.
 
     Example:
 
@@ -249,6 +325,19 @@ verilator_cc_library = rule(
         module = ":my_module",
     )
     ```
+
+    Functions imported with `import "DPI-C"` are implemented in `dpi_srcs`, which
+    can include the generated `V<module>__Dpi.h` header, and may call into any
+    C++ libraries (e.g. reference models) listed in `dpi_deps`:
+
+    ```python
+    verilator_cc_library(
+        name = "my_module_cc",
+        module = ":my_module",
+        dpi_srcs = ["my_module_dpi.cc"],
+        dpi_deps = [":my_reference_model"],
+    )
+    ```
     """,
     implementation = _verilator_cc_library_impl,
     attrs = {
@@ -256,15 +345,31 @@ verilator_cc_library = rule(
             doc = "Data used at runtime by the library",
             allow_files = True,
         ),
+        "dpi_deps": attr.label_list(
+            doc = "C++ libraries used by `dpi_srcs` which are linked into the model.",
+            providers = [CcInfo],
+        ),
+        "dpi_srcs": attr.label_list(
+            doc = "C/C++ sources implementing DPI-C imports of the module. These are compiled with access to the generated `V<module>__Dpi.h` header.",
+            allow_files = [".c", ".cc", ".cpp", ".cxx", ".h", ".hh", ".hpp"],
+        ),
         "linkopts": attr.string_list(
             doc = "List of additional C++ linker flags",
             default = [],
         ),
+        "linkstatic": attr.bool(
+            doc = (
+                "If False, a PIC shared library of the model is also produced and used by " +
+                "dependents linking in dynamic mode (e.g. `cc_test`). This avoids relinking " +
+                "the model objects into every binary."
+            ),
+            default = True,
+        ),
         "module": attr.label(
             doc = "The top level Verilog module target to compile with Verilator.",
             providers = [VerilogInfo],
             mandatory = True,
-            aspects = [_verilator_cc_aspect],
+            aspects = [verilator_cc_aspect],
         ),
     },
     provides = [
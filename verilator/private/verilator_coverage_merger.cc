@@ -0,0 +1,677 @@
+/**
+ * @file verilator_coverage_merger.cc
+ * @brief Merges Verilator `coverage.dat` files and LCOV tracefiles into a
+ * single LCOV report.
+ *
+ * The tool accepts the same flags Bazel passes to a coverage output generator
+ * (`--coverage_dir`, `--output_file`, `--filter_sources`, `--reports_file`)
+ * so it can be used as `--coverage_output_generator`, both for individual
+ * tests and for the combined report. Any additional positional arguments are
+ * treated as input files, which allows merging the outputs of many test
+ * shards outside of Bazel.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Struct to hold parsed command-line arguments.
+ */
+struct Args {
+    /** The directory to recursively search for coverage files. */
+    std::string coverage_dir;
+
+    /** A file listing coverage files to merge, one per line. */
+    std::string reports_file;
+
+    /** The LCOV file to write. */
+    std::string output_file;
+
+    /** Source files matching any of these patterns are dropped. */
+    std::vector<std::regex> filter_sources;
+
+    /** The number of threads to parse with (0 means hardware concurrency). */
+    unsigned jobs = 0;
+
+    /** Explicit input files. */
+    std::vector<std::string> inputs;
+};
+
+/**
+ * @brief The key of an LCOV branch record (`BRDA:<line>,<block>,<branch>`).
+ */
+using BranchKey = std::tuple<uint64_t, uint64_t, uint64_t>;
+
+/**
+ * @brief Coverage collected for a single source file.
+ */
+struct FileCoverage {
+    /** key: line number, value: execution count */
+    std::map<uint64_t, uint64_t> lines;
+
+    /** key: branch location, value: times taken */
+    std::map<BranchKey, uint64_t> branches;
+
+    /** key: function name, value: line number */
+    std::map<std::string, uint64_t> function_lines;
+
+    /** key: function name, value: execution count */
+    std::map<std::string, uint64_t> function_counts;
+
+    void merge(const FileCoverage& other) {
+        for (const std::pair<const uint64_t, uint64_t>& line : other.lines) {
+            lines[line.first] += line.second;
+        }
+        for (const std::pair<const BranchKey, uint64_t>& branch :
+             other.branches) {
+            branches[branch.first] += branch.second;
+        }
+        for (const std::pair<const std::string, uint64_t>& function :
+             other.function_lines) {
+            function_lines.emplace(function.first, function.second);
+        }
+        for (const std::pair<const std::string, uint64_t>& function :
+             other.function_counts) {
+            function_counts[function.first] += function.second;
+        }
+    }
+};
+
+/**
+ * @brief The result of parsing some number of coverage files.
+ */
+struct Coverage {
+    /** key: raw Verilator coverage point, value: count */
+    std::unordered_map<std::string, uint64_t> points;
+
+    /** key: source file, value: coverage parsed from LCOV inputs */
+    std::map<std::string, FileCoverage> files;
+
+    void merge(Coverage&& other) {
+        if (points.empty()) {
+            points = std::move(other.points);
+        } else {
+            for (std::pair<const std::string, uint64_t>& point :
+                 other.points) {
+                points[point.first] += point.second;
+            }
+        }
+        for (std::pair<const std::string, FileCoverage>& file : other.files) {
+            files[file.first].merge(file.second);
+        }
+    }
+};
+
+/**
+ * @brief Checks if a string starts with a given prefix.
+ *
+ * @param str The string to check.
+ * @param prefix The prefix to look for.
+ * @return true if str starts with prefix, false otherwise.
+ */
+bool starts_with(const std::string& str, const std::string& prefix) {
+    return str.size() >= prefix.size() &&
+           str.compare(0, prefix.size(), prefix) == 0;
+}
+
+/**
+ * @brief Parses an unsigned integer, treating anything invalid as zero.
+ *
+ * LCOV uses `-` for branches in blocks that were never executed.
+ *
+ * @param text The text to parse.
+ * @return The parsed value.
+ */
+uint64_t parse_count(const std::string& text) {
+    try {
+        return std::stoull(text);
+    } catch (const std::exception&) {
+        return 0;
+    }
+}
+
+/**
+ * @brief Parses command-line arguments into an Args struct.
+ *
+ * @param out_args The args object to populate
+ * @param argc The number of command-line arguments.
+ * @param argv The command-line argument array.
+ * @return 0 if parsing was successful
+ */
+int parse_args(Args& out_args, int argc, char* argv[]) {
+    Args args = {};
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (starts_with(arg, "--coverage_dir=")) {
+            // Length of "--coverage_dir="
+            int len = 15;
+            args.coverage_dir = arg.substr(len);
+        } else if (starts_with(arg, "--reports_file=")) {
+            // Length of "--reports_file="
+            int len = 15;
+            args.reports_file = arg.substr(len);
+        } else if (starts_with(arg, "--output_file=")) {
+            // Length of "--output_file="
+            int len = 14;
+            args.output_file = arg.substr(len);
+        } else if (starts_with(arg, "--filter_sources=")) {
+            // Length of "--filter_sources="
+            int len = 17;
+            args.filter_sources.emplace_back(arg.substr(len));
+        } else if (starts_with(arg, "--jobs=")) {
+            // Length of "--jobs="
+            int len = 7;
+            args.jobs = static_cast<unsigned>(parse_count(arg.substr(len)));
+        } else if (starts_with(arg, "--source_file_manifest=") ||
+                   starts_with(arg, "--sources_to_replace_file=")) {
+            // Passed by Bazel's `collect_coverage.sh` but only needed for
+            // formats this tool does not handle (gcov, JaCoCo).
+        } else if (starts_with(arg, "--")) {
+            std::cerr << "Error: Unknown argument: " << arg << std::endl;
+            return 1;
+        } else {
+            args.inputs.push_back(arg);
+        }
+    }
+
+    if (args.output_file.empty()) {
+        std::cerr << "Error: --output_file is required" << std::endl;
+        return 1;
+    }
+
+    out_args = args;
+    return 0;
+}
+
+/**
+ * @brief Reads the list of coverage files passed via `--reports_file`.
+ *
+ * Bazel passes this when building the combined report from the per-test
+ * `coverage.dat` files written by the output generator.
+ *
+ * @param path The file to read.
+ * @param inputs The list to append the listed files to.
+ * @return 0 if reading was successful
+ */
+int read_reports_file(const std::string& path,
+                      std::vector<std::string>& inputs) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        std::cerr << "Error: Failed to open reports file: " << path
+                  << std::endl;
+        return 1;
+    }
+
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty()) {
+            inputs.push_back(line);
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Parses a Verilator `coverage.dat` file.
+ *
+ * Each point is a line of the form `C '<key/value pairs>' <count>`. Points
+ * are aggregated by their raw key so identical points from different shards
+ * collapse into one.
+ *
+ * @param stream The stream to read from (positioned after the header).
+ * @param path The path of the file, for diagnostics.
+ * @param coverage The coverage to accumulate into.
+ * @return 0 if parsing was successful
+ */
+int parse_verilator_coverage(std::istream& stream, const std::string& path,
+                             Coverage& coverage) {
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        size_t start = line.find('\'');
+        size_t end = line.rfind('\'');
+        if (!starts_with(line, "C ") || start == std::string::npos ||
+            end == start) {
+            std::cerr << "Error: Malformed coverage point in " << path << ": "
+                      << line << std::endl;
+            return 1;
+        }
+
+        coverage.points[line.substr(start + 1, end - start - 1)] +=
+            parse_count(line.substr(end + 1));
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Parses an LCOV tracefile.
+ *
+ * @param stream The stream to read from.
+ * @param coverage The coverage to accumulate into.
+ */
+void parse_lcov(std::istream& stream, Coverage& coverage) {
+    FileCoverage* current = nullptr;
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        if (starts_with(line, "SF:")) {
+            current = &coverage.files[line.substr(3)];
+            continue;
+        }
+        if (line == "end_of_record") {
+            current = nullptr;
+            continue;
+        }
+        if (current == nullptr) {
+            continue;
+        }
+
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        std::string tag = line.substr(0, colon);
+        std::string rest = line.substr(colon + 1);
+
+        std::vector<std::string> fields;
+
+        if (tag == "DA" || tag == "BRDA") {
+            size_t pos = 0;
+            size_t next = 0;
+            while ((next = rest.find(',', pos)) != std::string::npos) {
+                fields.push_back(rest.substr(pos, next - pos));
+                pos = next + 1;
+            }
+            fields.push_back(rest.substr(pos));
+        }
+
+        if (tag == "DA" && fields.size() >= 2) {
+            current->lines[parse_count(fields[0])] += parse_count(fields[1]);
+        } else if (tag == "BRDA" && fields.size() == 4) {
+            BranchKey key(parse_count(fields[0]), parse_count(fields[1]),
+                          parse_count(fields[2]));
+            current->branches[key] += parse_count(fields[3]);
+        } else if (tag == "FN") {
+            // `FN:<line>,<name>` or `FN:<line>,<end line>,<name>`
+            size_t first = rest.find(',');
+            size_t last = rest.rfind(',');
+            if (first != std::string::npos) {
+                current->function_lines.emplace(
+                    rest.substr(last + 1), parse_count(rest.substr(0, first)));
+            }
+        } else if (tag == "FNDA") {
+            size_t comma = rest.find(',');
+            if (comma != std::string::npos) {
+                current->function_counts[rest.substr(comma + 1)] +=
+                    parse_count(rest.substr(0, comma));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Parses a single coverage file, detecting its format.
+ *
+ * @param path The file to parse.
+ * @param coverage The coverage to accumulate into.
+ * @return 0 if parsing was successful
+ */
+int parse_file(const std::string& path, Coverage& coverage) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        std::cerr << "Error: Failed to open coverage file: " << path
+                  << std::endl;
+        return 1;
+    }
+
+    std::string header;
+    std::getline(stream, header);
+    if (starts_with(header, "# SystemC::Coverage")) {
+        return parse_verilator_coverage(stream, path, coverage);
+    }
+
+    stream.clear();
+    stream.seekg(0);
+    parse_lcov(stream, coverage);
+    return 0;
+}
+
+/**
+ * @brief Determines whether a file found in the coverage directory should be
+ * parsed.
+ *
+ * @param path The file to check.
+ * @return true if the file is a Verilator or LCOV coverage file.
+ */
+bool is_coverage_file(const fs::path& path) {
+    std::string extension = path.extension().string();
+    if (extension == ".dat" || extension == ".info") {
+        return true;
+    }
+
+    std::ifstream stream(path, std::ios::binary);
+    std::string header;
+    std::getline(stream, header);
+    return starts_with(header, "# SystemC::Coverage");
+}
+
+/**
+ * @brief Extracts the value of a key from a Verilator coverage point.
+ *
+ * Points are encoded as `\001<key>\002<value>` pairs.
+ *
+ * @param point The raw coverage point.
+ * @param key The key to look up.
+ * @return The value, or an empty string if the key is not present.
+ */
+std::string point_value(const std::string& point, const std::string& key) {
+    std::string needle = "\001" + key + "\002";
+    size_t start = point.find(needle);
+    if (start == std::string::npos) {
+        return {};
+    }
+    start += needle.size();
+    size_t end = point.find('\001', start);
+    return point.substr(start, end == std::string::npos ? std::string::npos
+                                                        : end - start);
+}
+
+/**
+ * @brief Returns the coverage type of a point (`line`, `toggle`, ...).
+ *
+ * @param point The raw coverage point.
+ * @return The coverage type.
+ */
+std::string point_type(const std::string& point) {
+    std::string type = point_value(point, "t");
+    if (!type.empty()) {
+        return type;
+    }
+
+    // Pages are named `v_<type>/<module>`.
+    std::string page = point_value(point, "page");
+    if (starts_with(page, "v_")) {
+        return page.substr(2, page.find('/') - 2);
+    }
+    return page;
+}
+
+/**
+ * @brief Expands a Verilator line range (e.g. `12-14,16`) into line numbers.
+ *
+ * @param ranges The range specification.
+ * @return The covered lines.
+ */
+std::vector<uint64_t> expand_lines(const std::string& ranges) {
+    std::vector<uint64_t> lines;
+    size_t pos = 0;
+    while (pos < ranges.size()) {
+        size_t next = ranges.find(',', pos);
+        std::string range = ranges.substr(
+            pos, next == std::string::npos ? std::string::npos : next - pos);
+        size_t dash = range.find('-');
+        uint64_t first = parse_count(range.substr(0, dash));
+        uint64_t last = dash == std::string::npos
+                            ? first
+                            : parse_count(range.substr(dash + 1));
+        for (uint64_t line = first; line != 0 && line <= last; ++line) {
+            lines.push_back(line);
+        }
+        if (next == std::string::npos) {
+            break;
+        }
+        pos = next + 1;
+    }
+    return lines;
+}
+
+/**
+ * @brief Derives a stable LCOV branch number for a coverage point.
+ *
+ * Reports are merged again by `(line, block, branch)` (e.g. for Bazel's
+ * combined report), so the number must identify the point itself rather
+ * than its position among the points a single report saw on that line.
+ * This is a 31 bit FNV-1a hash of the point's page, hierarchy, and comment.
+ *
+ * @param point The raw coverage point.
+ * @return The branch number.
+ */
+uint64_t branch_number(const std::string& point) {
+    std::string identity = point_value(point, "page") + '\001' +
+                           point_value(point, "h") + '\001' +
+                           point_value(point, "o");
+
+    uint32_t hash = 2166136261u;
+    for (char c : identity) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+    return hash & 0x7fffffffu;
+}
+
+/**
+ * @brief Converts merged Verilator coverage points into LCOV records.
+ *
+ * Line and branch points become `DA` records for every line they cover.
+ * Toggle, user and any other points become `BRDA` records on their line,
+ * numbered by `branch_number` so reports from different runs line up.
+ *
+ * @param points The merged coverage points.
+ * @param files The per-file coverage to accumulate into.
+ */
+void convert_points(const std::unordered_map<std::string, uint64_t>& points,
+                    std::map<std::string, FileCoverage>& files) {
+    for (const std::pair<const std::string, uint64_t>& point : points) {
+        const std::string& key = point.first;
+        uint64_t count = point.second;
+
+        std::string filename = point_value(key, "f");
+        uint64_t lineno = parse_count(point_value(key, "l"));
+        if (filename.empty() || lineno == 0) {
+            continue;
+        }
+
+        FileCoverage& file = files[filename];
+        std::string type = point_type(key);
+        if (type == "line" || type == "block" || type == "branch") {
+            std::string ranges = point_value(key, "S");
+            std::vector<uint64_t> lines =
+                ranges.empty() ? std::vector<uint64_t>{lineno}
+                               : expand_lines(ranges);
+            for (uint64_t line : lines) {
+                file.lines[line] += count;
+            }
+        } else {
+            file.branches[BranchKey(lineno, 0, branch_number(key))] += count;
+        }
+    }
+}
+
+/**
+ * @brief Writes coverage as an LCOV tracefile.
+ *
+ * @param files The per-file coverage to write.
+ * @param filters Source files matching any of these patterns are skipped.
+ * @param output The stream to write to.
+ */
+void write_lcov(const std::map<std::string, FileCoverage>& files,
+                const std::vector<std::regex>& filters, std::ostream& output) {
+    for (const std::pair<const std::string, FileCoverage>& entry : files) {
+        const std::string& filename = entry.first;
+        const FileCoverage& file = entry.second;
+
+        bool filtered = false;
+        for (const std::regex& filter : filters) {
+            if (std::regex_match(filename, filter)) {
+                filtered = true;
+                break;
+            }
+        }
+        if (filtered) {
+            continue;
+        }
+
+        output << "SF:" << filename << "\n";
+
+        uint64_t functions_hit = 0;
+        for (const std::pair<const std::string, uint64_t>& function :
+             file.function_lines) {
+            output << "FN:" << function.second << "," << function.first
+                   << "\n";
+        }
+        for (const std::pair<const std::string, uint64_t>& function :
+             file.function_lines) {
+            std::map<std::string, uint64_t>::const_iterator it =
+                file.function_counts.find(function.first);
+            uint64_t count = it == file.function_counts.end() ? 0 : it->second;
+            output << "FNDA:" << count << "," << function.first << "\n";
+            functions_hit += count > 0 ? 1 : 0;
+        }
+        output << "FNF:" << file.function_lines.size() << "\n";
+        output << "FNH:" << functions_hit << "\n";
+
+        uint64_t branches_hit = 0;
+        for (const std::pair<const BranchKey, uint64_t>& branch :
+             file.branches) {
+            output << "BRDA:" << std::get<0>(branch.first) << ","
+                   << std::get<1>(branch.first) << ","
+                   << std::get<2>(branch.first) << "," << branch.second
+                   << "\n";
+            branches_hit += branch.second > 0 ? 1 : 0;
+        }
+        output << "BRF:" << file.branches.size() << "\n";
+        output << "BRH:" << branches_hit << "\n";
+
+        uint64_t lines_hit = 0;
+        for (const std::pair<const uint64_t, uint64_t>& line : file.lines) {
+            output << "DA:" << line.first << "," << line.second << "\n";
+            lines_hit += line.second > 0 ? 1 : 0;
+        }
+        output << "LH:" << lines_hit << "\n";
+        output << "LF:" << file.lines.size() << "\n";
+        output << "end_of_record\n";
+    }
+}
+
+/**
+ * @brief Parses all inputs using a pool of worker threads.
+ *
+ * Each worker accumulates into its own hash map which are combined once all
+ * files have been read, so no locking is needed while parsing.
+ *
+ * @param inputs The files to parse.
+ * @param jobs The number of worker threads.
+ * @param coverage The merged result.
+ * @return 0 if parsing was successful
+ */
+int parse_parallel(const std::vector<std::string>& inputs, unsigned jobs,
+                   Coverage& coverage) {
+    if (jobs == 0) {
+        jobs = std::max(1u, std::thread::hardware_concurrency());
+    }
+    jobs = static_cast<unsigned>(
+        std::min<size_t>(jobs, std::max<size_t>(1, inputs.size())));
+
+    std::vector<Coverage> partials(jobs);
+    std::vector<int> results(jobs, 0);
+    std::atomic<size_t> next(0);
+
+    std::vector<std::thread> workers;
+    workers.reserve(jobs);
+    for (unsigned i = 0; i < jobs; ++i) {
+        workers.emplace_back([&, i]() {
+            size_t index = 0;
+            while ((index = next.fetch_add(1)) < inputs.size()) {
+                if (parse_file(inputs[index], partials[i])) {
+                    results[i] = 1;
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    for (unsigned i = 0; i < jobs; ++i) {
+        if (results[i]) {
+            return 1;
+        }
+        coverage.merge(std::move(partials[i]));
+    }
+
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    Args args = {};
+    if (parse_args(args, argc, argv)) {
+        std::cerr << "Error: Failed to parse arguments" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> inputs = args.inputs;
+    if (!args.reports_file.empty() &&
+        read_reports_file(args.reports_file, inputs)) {
+        return 1;
+    }
+    if (!args.coverage_dir.empty() && fs::is_directory(args.coverage_dir)) {
+        std::vector<std::string> found;
+        for (const fs::directory_entry& entry :
+             fs::recursive_directory_iterator(args.coverage_dir)) {
+            if (entry.is_regular_file() && is_coverage_file(entry.path())) {
+                found.push_back(entry.path().string());
+            }
+        }
+        std::sort(found.begin(), found.end());
+        inputs.insert(inputs.end(), found.begin(), found.end());
+    }
+
+    Coverage coverage;
+    if (parse_parallel(inputs, args.jobs, coverage)) {
+        return 1;
+    }
+
+    convert_points(coverage.points, coverage.files);
+
+    fs::path output_path(args.output_file);
+    if (output_path.has_parent_path()) {
+        fs::create_directories(output_path.parent_path());
+    }
+
+    std::ofstream output(args.output_file, std::ios::binary);
+    if (!output) {
+        std::cerr << "Error: Failed to create output file: " << args.output_file
+                  << std::endl;
+        return 1;
+    }
+    write_lcov(coverage.files, args.filter_sources, output);
+
+    return 0;
+}
@@ -1,7 +1,9 @@
 """Verilator lint rules."""
 
+load("@bazel_skylib//rules:common_settings.bzl", "BuildSettingInfo")
 load("//verilog:verilog_info.bzl", "VerilogInfo")
-load(":verilator_utils.bzl", "collect_transitive_verilog_sources")
+load(":verilator_cc.bzl", "VerilatorCcInfo", "verilator_cc_aspect")
+load(":verilator_utils.bzl", "collect_transitive_verilog_sources", "verilator_lint_enabled")
 
 def _rlocationpath(file, workspace_name):
     if file.short_path.startswith("../"):
@@ -9,35 +11,25 @@ def _rlocationpath(file, workspace_name):
 
     return "{}/{}".format(workspace_name, file.short_path)
 
-def _verilator_lint_aspect_impl(target, ctx):
-    """Aspect implementation that lints Verilog using Verilator.
-
-    This aspect runs transitively on VerilogInfo targets and performs linting.
-    """
-
-    # Only process targets with VerilogInfo
-    if VerilogInfo not in target:
-        return []
-
-    # Skip external targets
-    if target.label.workspace_root.startswith("external"):
-        return []
+def _verilator_lint_args(ctx, verilator_toolchain, direct_srcs, includes, lint_result = None):
+    """Build the arguments for a `VerilatorLint` action.
 
-    # Skip if tagged with no-verilator-lint
-    sanitized_tags = [t.replace("-", "_") for t in ctx.rule.attr.tags]
-    for skip in ["no_verilator_lint", "no_lint", "nolint"]:
-        if skip in sanitized_tags:
-            return []
+    Args:
+        ctx (ctx): The rule or aspect context.
+        verilator_toolchain (ToolchainInfo): The Verilator toolchain.
+        direct_srcs (depset[File]): The sources of the module to lint.
+        includes (list[str]): Include directories for the module and its deps.
+        lint_result (File, optional): A file to record the lint result in
+            instead of failing the action.
 
-    verilator_toolchain = ctx.toolchains["//verilator:toolchain_type"]
-
-    # Collect all verilog sources transitively
-    direct_srcs, includes, inputs = collect_transitive_verilog_sources(target[VerilogInfo])
-
-    # Build verilator lint command
+    Returns:
+        Args: The process wrapper arguments.
+    """
     args = ctx.actions.args()
     args.add(verilator_toolchain.verilator, format = "--verilator=%s")
     args.add_all(direct_srcs, format_each = "--src=%s")
+    if lint_result:
+        args.add(lint_result, format = "--lint_result=%s")
     args.add("--capture_output")
 
     # Add delimiter before verilator arguments
@@ -54,6 +46,25 @@ def _verilator_lint_aspect_impl(target, ctx):
     # Add verilog files (will be replaced by wrapper via source_mappings)
     args.add_all(direct_srcs)
 
+    return args
+
+def _verilator_lint_action(target, ctx):
+    """Register a standalone `--lint-only` action for a target.
+
+    Args:
+        target (Target): The target to lint.
+        ctx (ctx): The aspect's context object.
+
+    Returns:
+        File: A marker file created when lint succeeds.
+    """
+    verilator_toolchain = ctx.toolchains["//verilator:toolchain_type"]
+
+    # Collect all verilog sources transitively
+    direct_srcs, includes, inputs = collect_transitive_verilog_sources(target[VerilogInfo])
+
+    args = _verilator_lint_args(ctx, verilator_toolchain, direct_srcs, includes)
+
     # Declare output file
     lint_ok = ctx.actions.declare_file("{}.verilator_lint.ok".format(target.label.name))
 
@@ -69,64 +80,127 @@ def _verilator_lint_aspect_impl(target, ctx):
         },
     )
 
+    return lint_ok
+
+def _verilator_lint_aspect_impl(target, ctx):
+    """Aspect implementation that lints Verilog using Verilator.
+
+    This aspect runs transitively on VerilogInfo targets and performs linting.
+    """
+
+    # Only process targets with VerilogInfo
+    if VerilogInfo not in target:
+        return []
+
+    # Skip external and opted out targets
+    if not verilator_lint_enabled(target, ctx):
+        return []
+
+    # With `fuse_lint`, `verilator_fused_lint_aspect` provides the lint check.
+    # Both aspects may be applied (e.g. `--config=strict` during `bazel test`) and
+    # an output group can only be provided once.
+    if ctx.attr._fuse_lint[BuildSettingInfo].value:
+        return []
+
     return [
         OutputGroupInfo(
-            verilator_lint_check = depset([lint_ok]),
+            verilator_lint_check = depset([_verilator_lint_action(target, ctx)]),
         ),
     ]
 
+_LINT_ASPECT_ATTRS = {
+    "_verilator_process_wrapper": attr.label(
+        doc = "The Verilator process wrapper binary.",
+        cfg = "exec",
+        executable = True,
+        default = Label("//verilator/private:verilator_process_wrapper"),
+    ),
+}
+
 verilator_lint_aspect = aspect(
     implementation = _verilator_lint_aspect_impl,
-    doc = "Aspect for linting Verilog modules with Verilator.",
+    doc = """Aspect for linting Verilog modules with Verilator.
+
+    With `--@rules_verilog//verilator/settings:fuse_lint` this aspect does nothing
+    and `verilator_fused_lint_aspect` lints instead.
+    """,
     required_providers = [VerilogInfo],
-    attrs = {
-        "_verilator_process_wrapper": attr.label(
-            doc = "The Verilator process wrapper binary.",
-            cfg = "exec",
-            executable = True,
-            default = Label("//verilator/private:verilator_process_wrapper"),
+    attrs = dict(_LINT_ASPECT_ATTRS, **{
+        "_fuse_lint": attr.label(
+            doc = "Whether or not lint is part of the Verilate action.",
+            default = Label("//verilator/settings:fuse_lint"),
         ),
-    },
+    }),
     toolchains = [
         "//verilator:toolchain_type",
     ],
 )
 
-def _verilator_lint_test_impl(ctx):
-    verilator_toolchain = ctx.toolchains["//verilator:toolchain_type"]
+def _verilator_fused_lint_aspect_impl(target, ctx):
+    """Aspect implementation that reuses the Verilate action of the cc aspect for lint."""
 
-    direct_srcs, includes, inputs = collect_transitive_verilog_sources(ctx.attr.module[VerilogInfo])
+    # Only process targets with VerilogInfo
+    if VerilogInfo not in target:
+        return []
 
-    verilog_files = [_rlocationpath(f, ctx.workspace_name) for f in direct_srcs.to_list()]
+    # Skip external and opted out targets
+    if not verilator_lint_enabled(target, ctx):
+        return []
 
-    # Build the lint command arguments list
-    test_args = []
-    test_args.append("--verilator={}".format(_rlocationpath(verilator_toolchain.verilator, ctx.workspace_name)))
-    for path in verilog_files:
-        test_args.append("--src={}".format(path))
-    test_args.append("--capture_output")
+    # The Verilate action from the cc aspect lints with `-Wall --timing`. It is
+    # shared with any `verilator_cc_library` that depends on the target so sources
+    # are only elaborated once. Without a fused check (`fuse_lint` is off) the
+    # standalone action is used instead.
+    lint_check = None
+    if VerilatorCcInfo in target:
+        lint_check = target[VerilatorCcInfo].lint_check
+    if not lint_check:
+        lint_check = _verilator_lint_action(target, ctx)
 
-    # Add delimiter before verilator arguments
-    test_args.append("--")
+    return [
+        OutputGroupInfo(
+            verilator_lint_check = depset([lint_check]),
+        ),
+    ]
 
-    # Add verilator flags
-    test_args.extend([
-        "--lint-only",
-        "--no-std",
-        "--timing",
-        "-Wall",
-    ])
-    test_args.extend(["-I{}".format(path) for path in includes])
-    test_args.extend(verilator_toolchain.vopts)
+verilator_fused_lint_aspect = aspect(
+    implementation = _verilator_fused_lint_aspect_impl,
+    doc = """Aspect for linting Verilog modules as part of the Verilate action of `verilator_cc_library`.
 
-    # Add verilog files (will be replaced by wrapper via source_mappings)
-    test_args.extend(verilog_files)
+    Requires `--@rules_verilog//verilator/settings:fuse_lint`, and produces the same
+    `verilator_lint_check` output group as `verilator_lint_aspect`. Every linted
+    target is verilated, which is only cheaper than `verilator_lint_aspect` when
+    most linted targets are already built into a `verilator_cc_library` (e.g.
+    `bazel test //...`).
 
-    # Write arguments to a file (newline delimited)
-    args_file = ctx.actions.declare_file(ctx.label.name + ".verilator_lint_args.txt")
-    ctx.actions.write(
-        output = args_file,
-        content = "\n".join(test_args) + "\n",
+    Fused lint is narrower than the standalone lint: Verilator only elaborates the
+    hierarchy below the top module of each target, so modules in `srcs` which the
+    top module does not instantiate are not linted.
+    """,
+    required_providers = [VerilogInfo],
+    requires = [verilator_cc_aspect],
+    attrs = _LINT_ASPECT_ATTRS,
+    toolchains = [
+        "//verilator:toolchain_type",
+    ],
+)
+
+def _verilator_lint_test_impl(ctx):
+    verilator_toolchain = ctx.toolchains["//verilator:toolchain_type"]
+
+    direct_srcs, includes, inputs = collect_transitive_verilog_sources(ctx.attr.module[VerilogInfo])
+
+    # Lint in a cacheable action. Its result (including any diagnostics) is
+    # recorded rather than failing the build so it can be reported by the test.
+    lint_result = ctx.actions.declare_file(ctx.label.name + ".verilator_lint.txt")
+
+    ctx.actions.run(
+        arguments = [_verilator_lint_args(ctx, verilator_toolchain, direct_srcs, includes, lint_result)],
+        mnemonic = "VerilatorLint",
+        executable = ctx.executable._verilator_process_wrapper,
+        tools = verilator_toolchain.all_files,
+        inputs = inputs,
+        outputs = [lint_result],
     )
 
     # Create a symlink to the process wrapper as the test executable
@@ -140,13 +214,10 @@ def _verilator_lint_test_impl(ctx):
     return [
         DefaultInfo(
             executable = test_executable,
-            runfiles = ctx.runfiles(
-                files = [args_file],
-                transitive_files = depset(transitive = [inputs, verilator_toolchain.all_files]),
-            ),
+            runfiles = ctx.runfiles(files = [lint_result]),
         ),
         testing.TestEnvironment({
-            "RULES_VERILOG_VERILATOR_ARGS_FILE": _rlocationpath(args_file, ctx.workspace_name),
+            "RULES_VERILOG_VERILATOR_LINT_RESULT": _rlocationpath(lint_result, ctx.workspace_name),
         }),
     ]
 
@@ -156,6 +227,9 @@ verilator_lint_test = rule(
     This rule runs Verilator in lint-only mode on the specified module
     and all its transitive dependencies. The test passes if linting succeeds.
 
+    Linting happens in a build action so its result is cached; the test only
+    reports the outcome and prints any diagnostics to the test log.
+
     Example:
         verilog_library(
             name = "my_module",
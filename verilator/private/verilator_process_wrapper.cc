@@ -3,13 +3,16 @@
  * @brief A process wrapper for Verilator actions (compile and lint).
  */
 
+#include <algorithm>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #ifndef _WIN32
@@ -33,7 +36,7 @@ struct Args {
     /** The path to verilator. */
     std::string verilator_binary;
 
-    /** key: original path, value: resolved path */
+    /** key: original path, value: normalized path */
     std::map<std::string, std::string> source_mappings;
 
     /** key: original path, value: normalized path (never runfiles) */
@@ -45,6 +48,12 @@ struct Args {
     /** The optional headers output dir */
     std::string output_hdrs;
 
+    /** Path prefixes to rewrite in generated sources, longest first */
+    std::vector<std::pair<std::string, std::string>> path_prefix_maps;
+
+    /** The optional file to record the lint result in instead of failing */
+    std::string lint_result;
+
     /** Whether to capture subprocess output */
     bool capture_output = false;
 
@@ -74,28 +83,15 @@ std::string normalize_path(const std::string& path) {
     return fs::path(path).make_preferred().string();
 }
 
-std::string resolve_path(const std::string& path, Runfiles* runfiles) {
-    if (runfiles != nullptr) {
-        std::string resolved_path = runfiles->Rlocation(path);
-        if (!resolved_path.empty()) {
-            return resolved_path;
-        }
-    }
-
-    return normalize_path(path);
-}
-
 /**
  * @brief Parses command-line arguments into an Args struct.
  *
  * @param out_args The args object to populate
  * @param argc The number of command-line arguments.
  * @param argv The command-line argument array.
- * @param runfiles Optional runfiles instance for path resolution.
- * @param use_runfiles Whether to use runfiles for path resolution.
  * @return 0 if parsing was successful
  */
-int parse_args(Args& out_args, int argc, char* argv[], Runfiles* runfiles) {
+int parse_args(Args& out_args, int argc, char* argv[]) {
     Args args = {};
     bool after_delimiter = false;
 
@@ -143,12 +139,12 @@ int parse_args(Args& out_args, int argc, char* argv[], Runfiles* runfiles) {
         } else if (starts_with(arg, "--verilator=")) {
             // Length of "--verilator="
             int len = 12;
-            args.verilator_binary = resolve_path(arg.substr(len), runfiles);
+            args.verilator_binary = normalize_path(arg.substr(len));
         } else if (starts_with(arg, "--src=")) {
             // Length of "--src="
             int len = 6;
             std::string src_path = arg.substr(len);
-            args.source_mappings[src_path] = resolve_path(src_path, runfiles);
+            args.source_mappings[src_path] = normalize_path(src_path);
         } else if (starts_with(arg, "--output=")) {
             // Length of "--output="
             int len = 9;
@@ -163,6 +159,22 @@ int parse_args(Args& out_args, int argc, char* argv[], Runfiles* runfiles) {
             // Length of "--output_hdrs="
             int len = 14;
             args.output_hdrs = arg.substr(len);
+        } else if (starts_with(arg, "--path_prefix_map=")) {
+            // Length of "--path_prefix_map="
+            int len = 18;
+            std::string mapping = arg.substr(len);
+            size_t eq = mapping.find('=');
+            if (eq == std::string::npos || eq == 0) {
+                std::cerr << "Error: Expected --path_prefix_map=FROM=TO: "
+                          << arg << std::endl;
+                return 1;
+            }
+            args.path_prefix_maps.emplace_back(mapping.substr(0, eq),
+                                               mapping.substr(eq + 1));
+        } else if (starts_with(arg, "--lint_result=")) {
+            // Length of "--lint_result="
+            int len = 14;
+            args.lint_result = arg.substr(len);
         } else if (arg == "--capture_output") {
             args.capture_output = true;
         } else {
@@ -228,6 +240,51 @@ int delete_matching_files(const std::string& dir,
     return 0;
 }
 
+/**
+ * @brief Copies a generated file, rewriting path prefixes in its content.
+ *
+ * Verilator embeds the paths it was given (sources, `--Mdir`) into generated
+ * code. Rewriting configuration and machine specific prefixes keeps the
+ * output identical across output directories and sandboxes so downstream
+ * compile actions can hit the cache.
+ *
+ * @param src The file to copy.
+ * @param dest The destination file.
+ * @param path_prefix_maps Prefixes to rewrite, longest first.
+ * @return A non-zero exit code if any issues occurred.
+ */
+int copy_with_path_prefix_maps(
+    const fs::path& src, const fs::path& dest,
+    const std::vector<std::pair<std::string, std::string>>& path_prefix_maps) {
+    std::ifstream input(src, std::ios::binary);
+    if (!input) {
+        std::cerr << "Error: Failed to open " << src << std::endl;
+        return 1;
+    }
+    std::string content((std::istreambuf_iterator<char>(input)),
+                        std::istreambuf_iterator<char>());
+    input.close();
+
+    for (const std::pair<std::string, std::string>& mapping :
+         path_prefix_maps) {
+        const std::string& original = mapping.first;
+        const std::string& replacement = mapping.second;
+        size_t pos = 0;
+        while ((pos = content.find(original, pos)) != std::string::npos) {
+            content.replace(pos, original.length(), replacement);
+            pos += replacement.length();
+        }
+    }
+
+    std::ofstream output(dest, std::ios::binary | std::ios::trunc);
+    if (!output) {
+        std::cerr << "Error: Failed to create " << dest << std::endl;
+        return 1;
+    }
+    output << content;
+    return 0;
+}
+
 /**
  * @brief Copies files from output directory to separate source and header
  * directories.
@@ -235,11 +292,13 @@ int delete_matching_files(const std::string& dir,
  * @param output_dir The output directory containing generated files.
  * @param output_srcs The destination directory for source files (cc/cpp/c).
  * @param output_hdrs The destination directory for header files (h/hpp/hh).
+ * @param path_prefix_maps Prefixes to rewrite in copied files.
  * @return A non-zero exit code if any issues occurred.
  */
-int copy_and_filter_outputs(const std::string& output_dir,
-                            const std::string& output_srcs,
-                            const std::string& output_hdrs) {
+int copy_and_filter_outputs(
+    const std::string& output_dir, const std::string& output_srcs,
+    const std::string& output_hdrs,
+    const std::vector<std::pair<std::string, std::string>>& path_prefix_maps) {
     if (output_dir.empty() || (output_srcs.empty() && output_hdrs.empty())) {
         return 0;
     }
@@ -280,14 +339,8 @@ int copy_and_filter_outputs(const std::string& output_dir,
             }
 
             if (should_copy) {
-                // Copy the file
-                std::error_code ec;
-                fs::copy_file(entry.path(), dest_path,
-                              fs::copy_options::overwrite_existing, ec);
-                if (ec) {
-                    std::cerr << "Error: Failed to copy " << entry.path()
-                              << " to " << dest_path << " - " << ec.message()
-                              << std::endl;
+                if (copy_with_path_prefix_maps(entry.path(), dest_path,
+                                               path_prefix_maps)) {
                     return 1;
                 }
             }
@@ -401,67 +454,87 @@ int execute_command(const std::string& cmd, bool capture_output,
 #endif
 }
 
-int main(int argc, char* argv[]) {
-    // Check if we should load arguments from a file
-    const char* args_file_env =
-        std::getenv("RULES_VERILOG_VERILATOR_ARGS_FILE");
-    Args args = {};
+/**
+ * @brief Records the result of a lint run for `verilator_lint_test`.
+ *
+ * The first line of the file is the exit code of Verilator, the remainder is
+ * its captured output.
+ *
+ * @param path The result file to write.
+ * @param result The exit code of Verilator.
+ * @param captured_output The captured output of Verilator.
+ * @return A non-zero exit code if the file could not be written.
+ */
+int write_lint_result(const std::string& path, int result,
+                      const std::string& captured_output) {
+    std::ofstream output_file(path, std::ios::binary);
+    if (!output_file) {
+        std::cerr << "Error: Failed to create lint result: " << path
+                  << std::endl;
+        return 1;
+    }
 
-    if (args_file_env != nullptr) {
-        std::vector<std::string> file_args;
-        std::vector<char*> file_argv = {};
+    output_file << result << "\n" << captured_output;
+    return 0;
+}
 
-        std::string error;
-        std::unique_ptr<Runfiles> runfiles(
-            Runfiles::CreateForTest(BAZEL_CURRENT_REPOSITORY, &error));
-        if (runfiles == nullptr) {
-            std::cerr << "Error: Failed to create runfiles: " << error
-                      << std::endl;
-            return 1;
-        }
+/**
+ * @brief Replays a lint result recorded by `write_lint_result`.
+ *
+ * This is the entrypoint of `verilator_lint_test`. Linting already happened
+ * in a cacheable build action so the test only reports its outcome.
+ *
+ * @param result_path The runfiles path of the lint result.
+ * @return The exit code of the recorded Verilator invocation.
+ */
+int replay_lint_result(const std::string& result_path) {
+    std::string error;
+    std::unique_ptr<Runfiles> runfiles(
+        Runfiles::CreateForTest(BAZEL_CURRENT_REPOSITORY, &error));
+    if (runfiles == nullptr) {
+        std::cerr << "Error: Failed to create runfiles: " << error
+                  << std::endl;
+        return 1;
+    }
 
-        // Resolve the args file path via runfiles if needed
-        std::string args_file_path = args_file_env;
-        std::string resolved = runfiles->Rlocation(std::string(args_file_path));
-        if (resolved.empty()) {
-            std::cerr << "Error: Find runfile: " << args_file_path << std::endl;
-            return 1;
-        }
+    std::string resolved = runfiles->Rlocation(result_path);
+    if (resolved.empty()) {
+        std::cerr << "Error: Find runfile: " << result_path << std::endl;
+        return 1;
+    }
 
-        // Read arguments from file
-        std::ifstream args_file(resolved);
-        if (!args_file) {
-            std::cerr << "Error: Failed to open args file: " << resolved
-                      << std::endl;
-            return 1;
-        }
+    std::ifstream result_file(resolved, std::ios::binary);
+    if (!result_file) {
+        std::cerr << "Error: Failed to open lint result: " << resolved
+                  << std::endl;
+        return 1;
+    }
 
-        std::string line;
-        while (std::getline(args_file, line)) {
-            if (!line.empty()) {
-                file_args.push_back(line);
-            }
-        }
-        args_file.close();
+    std::string line;
+    if (!std::getline(result_file, line)) {
+        std::cerr << "Error: Empty lint result: " << resolved << std::endl;
+        return 1;
+    }
+    int result = std::atoi(line.c_str());
 
-        // Build new argv array from file args
-        file_argv.push_back(argv[0]);  // Keep program name
-        for (std::string& arg : file_args) {
-            file_argv.push_back(const_cast<char*>(arg.c_str()));
-        }
+    std::cout << result_file.rdbuf();
+    std::cout.flush();
 
-        // Parse arguments from file
-        if (parse_args(args, file_argv.size(), file_argv.data(),
-                       runfiles.get())) {
-            std::cerr << "Error: Failed to parse arguments" << std::endl;
-            return 1;
-        }
-    } else {
-        // Parse arguments from command line
-        if (parse_args(args, argc, argv, nullptr)) {
-            std::cerr << "Error: Failed to parse arguments" << std::endl;
-            return 1;
-        }
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    // `verilator_lint_test` only reports the result of a prior lint action.
+    const char* lint_result_env =
+        std::getenv("RULES_VERILOG_VERILATOR_LINT_RESULT");
+    if (lint_result_env != nullptr) {
+        return replay_lint_result(lint_result_env);
+    }
+
+    Args args = {};
+    if (parse_args(args, argc, argv)) {
+        std::cerr << "Error: Failed to parse arguments" << std::endl;
+        return 1;
     }
 
     // Build command
@@ -491,7 +564,13 @@ int main(int argc, char* argv[]) {
 
     // Execute verilator command with optional output capture
     std::string captured_output;
-    int result = execute_command(cmd, args.capture_output, captured_output);
+    int result = execute_command(
+        cmd, args.capture_output || !args.lint_result.empty(), captured_output);
+
+    // Lint failures are reported by `verilator_lint_test` at test time.
+    if (!args.lint_result.empty()) {
+        return write_lint_result(args.lint_result, result, captured_output);
+    }
 
     // Print captured output if needed
     if (args.capture_output && !captured_output.empty()) {
@@ -540,10 +619,23 @@ int main(int argc, char* argv[]) {
 
     // Copy and filter output files to separate source and header directories
     if (!args.output_srcs.empty() || !args.output_hdrs.empty()) {
+        // Absolute paths differ between sandboxes and machines. Strip the
+        // working directory (the exec root) in addition to requested maps.
+        std::string exec_root = fs::current_path().string();
+        args.path_prefix_maps.emplace_back(
+            exec_root + static_cast<char>(fs::path::preferred_separator), "");
+        std::stable_sort(
+            args.path_prefix_maps.begin(), args.path_prefix_maps.end(),
+            [](const std::pair<std::string, std::string>& lhs,
+               const std::pair<std::string, std::string>& rhs) {
+                return lhs.first.size() > rhs.first.size();
+            });
+
         for (auto it = args.output_mappings.begin();
              it != args.output_mappings.end(); ++it) {
             if (copy_and_filter_outputs(it->first, args.output_srcs,
-                                        args.output_hdrs)) {
+                                        args.output_hdrs,
+                                        args.path_prefix_maps)) {
                 return 1;
             }
         }
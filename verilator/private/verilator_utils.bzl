@@ -34,3 +34,26 @@ def collect_transitive_verilog_sources(verilog_info):
     ])
 
     return (verilog_info.srcs, depset(includes).to_list(), inputs)
+
+def verilator_lint_enabled(target, ctx):
+    """Determine whether or not a target should be linted.
+
+    External targets and targets tagged with `no-verilator-lint`, `no-lint`,
+    or `nolint` are skipped.
+
+    Args:
+        target (Target): The target an aspect is running on.
+        ctx (ctx): The aspect's context object.
+
+    Returns:
+        bool: True if the target should be linted.
+    """
+    if target.label.workspace_root.startswith("external"):
+        return False
+
+    sanitized_tags = [t.replace("-", "_") for t in ctx.rule.attr.tags]
+    for skip in ["no_verilator_lint", "no_lint", "nolint"]:
+        if skip in sanitized_tags:
+            return False
+
+    return True
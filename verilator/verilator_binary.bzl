@@ -0,0 +1,8 @@
+"""verilator_binary"""
+
+load(
+    "//verilator/private:verilator_binary.bzl",
+    _verilator_binary = "verilator_binary",
+)
+
+verilator_binary = _verilator_binary
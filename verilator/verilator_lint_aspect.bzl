@@ -2,7 +2,9 @@
 
 load(
     "//verilator/private:verilator_lint.bzl",
+    _verilator_fused_lint_aspect = "verilator_fused_lint_aspect",
     _verilator_lint_aspect = "verilator_lint_aspect",
 )
 
+verilator_fused_lint_aspect = _verilator_fused_lint_aspect
 verilator_lint_aspect = _verilator_lint_aspect
@@ -0,0 +1,8 @@
+"""verilator_test"""
+
+load(
+    "//verilator/private:verilator_binary.bzl",
+    _verilator_test = "verilator_test",
+)
+
+verilator_test = _verilator_test
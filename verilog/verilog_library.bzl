@@ -55,13 +55,21 @@ def _verilog_library_impl(ctx):
     transitive_deps = [dep.deps for dep in direct_deps]
     deps = depset(direct_deps, transitive = transitive_deps, order = "preorder")
 
-    return [VerilogInfo(
-        srcs = depset(ctx.files.srcs),
-        deps = deps,
-        compile_data = depset(ctx.files.compile_data),
-        hdrs = depset(ctx.files.hdrs),
-        top = top,
-    )]
+    return [
+        VerilogInfo(
+            srcs = depset(ctx.files.srcs),
+            deps = deps,
+            compile_data = depset(ctx.files.compile_data),
+            hdrs = depset(ctx.files.hdrs),
+            top = top,
+        ),
+        coverage_common.instrumented_files_info(
+            ctx,
+            source_attributes = ["srcs", "hdrs"],
+            dependency_attributes = ["deps"],
+            extensions = ["v", "sv", "vh", "svh"],
+        ),
+    ]
 
 verilog_library = rule(
     doc = "TODO",